@@ -0,0 +1,87 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include "datetime.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+
+// Process-wide source of "now" timestamps for messages, posts, comments and
+// replies. The local broken-down time is computed once per wall-clock second
+// and published through a sequence lock, so the common path is one
+// system_clock read plus a few atomic loads, and concurrent callers never
+// block each other.
+class Clock {
+private:
+    std::atomic<uint32_t> version;        // Odd while a refresh is in progress
+    std::atomic<int64_t> cachedSecond;    // Epoch second the cache describes
+    std::atomic<uint64_t> cachedTicks;    // DateTime ticks of that second
+    std::mutex refreshMutex;
+
+    Clock() : version(0), cachedSecond(INT64_MIN), cachedTicks(0) {}
+
+    Clock(const Clock&) = delete;
+    Clock& operator=(const Clock&) = delete;
+
+    // Recompute the broken-down time when the second rolls over
+    void refresh(int64_t epochSecond) {
+        std::lock_guard<std::mutex> lock(refreshMutex);
+        if (cachedSecond.load(std::memory_order_relaxed) == epochSecond) {
+            return;  // Another thread got here first
+        }
+
+        std::time_t time = static_cast<std::time_t>(epochSecond);
+        std::tm ltm{};
+#ifdef _WIN32
+        localtime_s(&ltm, &time);
+#else
+        localtime_r(&time, &ltm);
+#endif
+        DateTime base(ltm.tm_mday, 1 + ltm.tm_mon, 1900 + ltm.tm_year,
+                      ltm.tm_hour, ltm.tm_min, ltm.tm_sec);
+
+        // Seqlock write. The fence orders the odd version before the field
+        // stores: a reader that sees either new field then also sees the
+        // odd version on its second check and retries.
+        version.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        cachedTicks.store(base.getTicks(), std::memory_order_relaxed);
+        cachedSecond.store(epochSecond, std::memory_order_relaxed);
+        version.fetch_add(1, std::memory_order_release);
+    }
+
+public:
+    static Clock& getInstance() {
+        static Clock instance;
+        return instance;
+    }
+
+    // Current local time with microsecond precision
+    DateTime now() {
+        int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        int64_t second = micros / 1000000;
+        int microsecond = static_cast<int>(micros % 1000000);
+        if (microsecond < 0) {
+            microsecond += 1000000;
+            --second;
+        }
+
+        for (;;) {
+            uint32_t before = version.load(std::memory_order_acquire);
+            if ((before & 1) == 0 && cachedSecond.load(std::memory_order_relaxed) == second) {
+                uint64_t ticks = cachedTicks.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (version.load(std::memory_order_relaxed) == before) {
+                    return DateTime::fromTicks(ticks).withMicrosecond(microsecond);
+                }
+                continue;
+            }
+            refresh(second);
+        }
+    }
+};
+
+#endif // CLOCK_H
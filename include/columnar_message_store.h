@@ -0,0 +1,240 @@
+#ifndef COLUMNAR_MESSAGE_STORE_H
+#define COLUMNAR_MESSAGE_STORE_H
+
+#include "datetime.h"
+#include "facebook_exception.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// One bit per message position, least significant bit first
+using PositionBitmap = std::vector<uint64_t>;
+
+// Structure-of-arrays copy of a conversation's message metadata. Filters
+// that only need sender, receiver, time or read state scan these dense
+// columns with SIMD compares (AVX2 or SSE2 when the build enables them)
+// instead of following a pointer to every Message. Positions match the
+// order in which messages were added; Conversation::enableColumnarStore()
+// keeps one in step with the resident timeline.
+class ColumnarMessageStore {
+private:
+    std::vector<int32_t> senders;
+    std::vector<int32_t> receivers;
+    std::vector<uint64_t> timestamps;  // DateTime ticks
+    std::vector<uint8_t> readFlags;    // 1 once read
+
+    PositionBitmap emptyBitmap() const {
+        return PositionBitmap((size() + 63) / 64, 0);
+    }
+
+    static int popCount(uint64_t word) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(word);
+#else
+        int total = 0;
+        for (; word; word &= word - 1) ++total;
+        return total;
+#endif
+    }
+
+    static int lowestBit(uint64_t word) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(word);
+#else
+        int bit = 0;
+        while (!((word >> bit) & 1)) ++bit;
+        return bit;
+#endif
+    }
+
+    static void setBits(PositionBitmap& bitmap, std::size_t position, uint64_t bits, int width) {
+        bitmap[position / 64] |= (bits & ((uint64_t(1) << width) - 1)) << (position % 64);
+    }
+
+    // Compare a column of IDs to a value in blocks, optionally requiring the
+    // matching message to be unread
+    PositionBitmap matchIds(const std::vector<int32_t>& column, int32_t value, bool unreadOnly) const {
+        PositionBitmap bitmap = emptyBitmap();
+        const int32_t* ids = column.data();
+        const uint8_t* read = readFlags.data();
+        std::size_t count = column.size();
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        const __m256i target = _mm256_set1_epi32(value);
+        for (; i + 8 <= count; i += 8) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+            uint32_t bits = static_cast<uint32_t>(_mm256_movemask_ps(
+                _mm256_castsi256_ps(_mm256_cmpeq_epi32(block, target))));
+            if (unreadOnly && bits) {
+                __m128i flags = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(read + i));
+                bits &= ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(flags, _mm_setzero_si128()))) & 0xFF;
+            }
+            setBits(bitmap, i, bits, 8);
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128i target = _mm_set1_epi32(value);
+        for (; i + 4 <= count; i += 4) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + i));
+            uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, target))));
+            if (unreadOnly && bits) {
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (read[i + lane]) bits &= ~(1u << lane);
+                }
+            }
+            setBits(bitmap, i, bits, 4);
+        }
+#endif
+        for (; i < count; ++i) {
+            if (ids[i] == value && !(unreadOnly && read[i])) {
+                bitmap[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+        return bitmap;
+    }
+
+public:
+    // Append a message's metadata; MessageType needs the Message getters
+    template<typename MessageType>
+    std::size_t append(const MessageType& message) {
+        senders.push_back(message.getSenderId());
+        receivers.push_back(message.getReceiverId());
+        timestamps.push_back(message.getTimestamp().getTicks());
+        readFlags.push_back(message.isRead() ? 1 : 0);
+        return size() - 1;
+    }
+
+    // Insert a message's metadata at position, with its read state given
+    // by the caller (a message can count as read without isRead())
+    template<typename MessageType>
+    void insert(std::size_t position, const MessageType& message, bool read) {
+        if (position > size()) {
+            throw FacebookException("Message position out of range", "ValidationError");
+        }
+        senders.insert(senders.begin() + position, message.getSenderId());
+        receivers.insert(receivers.begin() + position, message.getReceiverId());
+        timestamps.insert(timestamps.begin() + position, message.getTimestamp().getTicks());
+        readFlags.insert(readFlags.begin() + position, read ? 1 : 0);
+    }
+
+    // Remove the first count positions
+    void eraseFront(std::size_t count) {
+        count = std::min(count, size());
+        senders.erase(senders.begin(), senders.begin() + count);
+        receivers.erase(receivers.begin(), receivers.begin() + count);
+        timestamps.erase(timestamps.begin(), timestamps.begin() + count);
+        readFlags.erase(readFlags.begin(), readFlags.begin() + count);
+    }
+
+    void clear() {
+        senders.clear();
+        receivers.clear();
+        timestamps.clear();
+        readFlags.clear();
+    }
+
+    void reserve(std::size_t count) {
+        senders.reserve(count);
+        receivers.reserve(count);
+        timestamps.reserve(count);
+        readFlags.reserve(count);
+    }
+
+    void markAsRead(std::size_t position) {
+        if (position >= size()) {
+            throw FacebookException("Message position out of range", "ValidationError");
+        }
+        readFlags[position] = 1;
+    }
+
+    // Mark every message to userId before position end as read
+    void markReadBy(int userId, std::size_t end) {
+        end = std::min(end, size());
+        for (std::size_t i = 0; i < end; ++i) {
+            readFlags[i] |= receivers[i] == userId ? 1 : 0;
+        }
+    }
+
+    // Accessors
+    std::size_t size() const { return senders.size(); }
+    int getSenderId(std::size_t position) const { return senders[position]; }
+    int getReceiverId(std::size_t position) const { return receivers[position]; }
+    DateTime getTimestamp(std::size_t position) const { return DateTime::fromTicks(timestamps[position]); }
+    bool isRead(std::size_t position) const { return readFlags[position] != 0; }
+
+    // Filters
+    PositionBitmap matchSender(int userId) const { return matchIds(senders, userId, false); }
+    PositionBitmap matchReceiver(int userId) const { return matchIds(receivers, userId, false); }
+    PositionBitmap matchUnread(int userId) const { return matchIds(receivers, userId, true); }
+
+    // Messages sent at or after from and before to
+    PositionBitmap matchBetween(const DateTime& from, const DateTime& to) const {
+        PositionBitmap bitmap = emptyBitmap();
+        const uint64_t* ticks = timestamps.data();
+        std::size_t count = timestamps.size();
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        // No unsigned 64-bit compare in AVX2: flip the sign bit and compare signed
+        const __m256i flip = _mm256_set1_epi64x(static_cast<long long>(uint64_t(1) << 63));
+        const __m256i low = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(from.getTicks() - 1)), flip);
+        const __m256i high = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(to.getTicks())), flip);
+        if (from.getTicks() > 0) {
+            for (; i + 4 <= count; i += 4) {
+                __m256i block = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ticks + i)), flip);
+                __m256i inside = _mm256_and_si256(_mm256_cmpgt_epi64(block, low), _mm256_cmpgt_epi64(high, block));
+                setBits(bitmap, i, static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(inside))), 4);
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            if (ticks[i] >= from.getTicks() && ticks[i] < to.getTicks()) {
+                bitmap[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+        return bitmap;
+    }
+
+    // Bitmap helpers
+    static void intersect(PositionBitmap& target, const PositionBitmap& other) {
+        for (std::size_t word = 0; word < target.size(); ++word) {
+            target[word] &= word < other.size() ? other[word] : 0;
+        }
+    }
+
+    static std::size_t countMatches(const PositionBitmap& bitmap) {
+        std::size_t total = 0;
+        for (uint64_t word : bitmap) {
+            total += static_cast<std::size_t>(popCount(word));
+        }
+        return total;
+    }
+
+    static std::vector<std::size_t> positions(const PositionBitmap& bitmap) {
+        std::vector<std::size_t> result;
+        for (std::size_t word = 0; word < bitmap.size(); ++word) {
+            for (uint64_t bits = bitmap[word]; bits; bits &= bits - 1) {
+                result.push_back(word * 64 + static_cast<std::size_t>(lowestBit(bits)));
+            }
+        }
+        return result;
+    }
+
+    // Which kernel the filters were compiled with
+    static const char* simdLevel() {
+#if defined(__AVX2__)
+        return "avx2";
+#elif defined(__SSE2__) || defined(_M_X64)
+        return "sse2";
+#else
+        return "scalar";
+#endif
+    }
+};
+
+#endif // COLUMNAR_MESSAGE_STORE_H
@@ -19,7 +19,6 @@ private:
     DateTime timestamp;
     std::vector<std::shared_ptr<Reply>> replies;
     std::vector<int> likerIds;  // IDs of users who liked this comment
-    static int nextId;  // For generating unique IDs
 
 public:
     // Constructor
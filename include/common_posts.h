@@ -0,0 +1,116 @@
+#ifndef COMMON_POSTS_H
+#define COMMON_POSTS_H
+
+#include "span.h"
+#include "sorted_intersection.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+class Post;
+
+// Entry in a user's post index. The ID is copied out of the post so the index
+// can be searched without touching the posts themselves; the pointer breaks
+// ties, since post IDs are assigned by callers and need not be unique.
+struct PostRef {
+    int id;
+    Post* post;
+
+    bool operator<(const PostRef& other) const {
+        return id != other.id ? id < other.id : std::less<Post*>()(post, other.post);
+    }
+    bool operator==(const PostRef& other) const { return id == other.id && post == other.post; }
+};
+
+// Lazily evaluated intersection of two post indexes sorted by PostRef order.
+// Each step of the iterator advances a merge; when one index is much longer
+// than the other, it is searched instead of walked. Like Span, the view is
+// invalidated by the next post added to or removed from either user.
+class CommonPosts {
+private:
+    Span<PostRef> shorter;
+    Span<PostRef> longer;
+    bool search;
+
+public:
+    class const_iterator {
+    private:
+        const PostRef* a;
+        const PostRef* aEnd;
+        const PostRef* b;
+        const PostRef* bEnd;
+        bool search;
+
+        // Move both cursors to the next entry present on both sides
+        void settle() {
+            while (a != aEnd && b != bEnd) {
+                if (*a < *b) {
+                    ++a;
+                } else if (*b < *a) {
+                    b = search ? std::lower_bound(b, bEnd, *a) : b + 1;
+                } else {
+                    return;
+                }
+            }
+            a = aEnd;
+            b = bEnd;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Post*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Post* const*;
+        using reference = Post* const&;
+
+        const_iterator(const PostRef* first, const PostRef* firstEnd, const PostRef* second, const PostRef* secondEnd,
+                       bool searchSecond)
+            : a(first), aEnd(firstEnd), b(second), bEnd(secondEnd), search(searchSecond) {
+            settle();
+        }
+
+        reference operator*() const { return a->post; }
+        const_iterator& operator++() {
+            ++a;
+            ++b;
+            settle();
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+        bool operator==(const const_iterator& other) const { return a == other.a; }
+        bool operator!=(const const_iterator& other) const { return a != other.a; }
+    };
+
+    CommonPosts(Span<PostRef> a, Span<PostRef> b)
+        : shorter(a.size() <= b.size() ? a : b), longer(a.size() <= b.size() ? b : a),
+          search(shorter.size() > 0 && longer.size() / shorter.size() >= SortedIntersection::GALLOP_RATIO) {}
+
+    // Common posts in increasing ID order
+    const_iterator begin() const {
+        return const_iterator(shorter.begin(), shorter.end(), longer.begin(), longer.end(), search);
+    }
+    const_iterator end() const {
+        return const_iterator(shorter.end(), shorter.end(), longer.end(), longer.end(), search);
+    }
+    bool empty() const { return begin() == end(); }
+
+    // Walks the whole intersection
+    std::size_t count() const { return static_cast<std::size_t>(std::distance(begin(), end())); }
+
+    // Materialize, for callers that keep the result. Appends in one pass
+    // rather than walking the intersection once more to size the vector.
+    operator std::vector<Post*>() const {
+        std::vector<Post*> posts;
+        for (Post* post : *this) {
+            posts.push_back(post);
+        }
+        return posts;
+    }
+};
+
+#endif // COMMON_POSTS_H
@@ -0,0 +1,193 @@
+#ifndef CONCURRENT_CONVERSATION_H
+#define CONCURRENT_CONVERSATION_H
+
+#include "facebook_exception.h"
+#include "id_generator.h"
+#include "participant_policy.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Conversation variant for hot chats that receive sends on many threads.
+// Producers append without locks: each one claims a slot with a single
+// fetch_add and fills it in place. Messages live in segments that double in
+// size (1024 slots, then 2048, ...), each installed with a CAS the first
+// time a slot in it is claimed, so an empty conversation allocates nothing
+// and nothing ever moves. Readers take wait-free snapshots of the published
+// prefix.
+//
+// Differences from Conversation: messages are kept in append order (their
+// sequence is their position + 1) rather than re-ordered by timestamp, and
+// the participant list is fixed at construction so that it can be read
+// concurrently.
+template<typename MessageType>
+class ConcurrentConversation {
+private:
+    static constexpr std::size_t FIRST_SEGMENT_SIZE = 1024;
+    static constexpr std::size_t MAX_SEGMENTS = 48;  // Far beyond any addressable size
+
+    struct Slot {
+        std::shared_ptr<MessageType> message;
+        std::atomic<bool> ready{false};
+    };
+
+    int id;
+    GroupPolicy members;
+    std::size_t limit;
+    std::atomic<Slot*> segments[MAX_SEGMENTS];
+    std::atomic<std::size_t> reserved;   // Slots claimed by producers
+    std::atomic<std::size_t> published;  // Slots [0, published) are complete or skipped
+
+    // Segment k holds FIRST_SEGMENT_SIZE << k slots, starting at slot
+    // FIRST_SEGMENT_SIZE * (2^k - 1)
+    static std::size_t segmentOf(std::size_t index, std::size_t& offset) {
+        uint64_t blocks = index / FIRST_SEGMENT_SIZE + 1;
+        std::size_t k = 0;
+        for (unsigned shift = 32; shift > 0; shift /= 2) {
+            if (blocks >> shift) {
+                blocks >>= shift;
+                k += shift;
+            }
+        }
+        offset = index - FIRST_SEGMENT_SIZE * ((std::size_t(1) << k) - 1);
+        return k;
+    }
+
+    // The slot, or null while its segment is not installed
+    Slot* findSlot(std::size_t index) const {
+        std::size_t offset = 0;
+        Slot* segment = segments[segmentOf(index, offset)].load(std::memory_order_acquire);
+        return segment ? segment + offset : nullptr;
+    }
+
+    Slot& claimSlot(std::size_t index) {
+        std::size_t offset = 0;
+        std::size_t k = segmentOf(index, offset);
+        std::atomic<Slot*>& entry = segments[k];
+        Slot* segment = entry.load(std::memory_order_acquire);
+        if (!segment) {
+            Slot* fresh = new Slot[FIRST_SEGMENT_SIZE << k];
+            if (entry.compare_exchange_strong(segment, fresh)) {
+                segment = fresh;
+            } else {
+                delete[] fresh;  // Another producer installed it first
+            }
+        }
+        return segment[offset];
+    }
+
+    // Extend the published prefix over every completed slot. Any producer may
+    // finish the work of another, so a slow producer only delays visibility
+    // of later messages, never their insertion.
+    void publish() {
+        std::size_t count = published.load();
+        while (count < limit && count < reserved.load()) {
+            // The slot's producer may not have installed its segment yet
+            Slot* slot = findSlot(count);
+            if (!slot || !slot->ready.load()) {
+                break;
+            }
+            if (published.compare_exchange_weak(count, count + 1)) {
+                ++count;
+            }
+        }
+    }
+
+    // A producer that claimed index but could not fill it (its segment
+    // could not be allocated, say) moves the prefix past the slot itself
+    // once every earlier slot is published, leaving a null message there.
+    // It cannot mark the slot instead, since the slot may not exist.
+    void skip(std::size_t index) {
+        std::size_t expected = index;
+        while (!published.compare_exchange_weak(expected, index + 1)) {
+            expected = index;
+            std::this_thread::yield();
+        }
+        publish();
+    }
+
+public:
+    // Read-only view of the messages published when it was taken
+    class Snapshot {
+    private:
+        const ConcurrentConversation* conversation;
+        std::size_t length;
+
+    public:
+        Snapshot(const ConcurrentConversation* source, std::size_t size) : conversation(source), length(size) {}
+
+        std::size_t size() const { return length; }
+        bool empty() const { return length == 0; }
+        // Null for the rare slot whose producer failed after claiming it
+        const std::shared_ptr<MessageType>& operator[](std::size_t index) const {
+            static const std::shared_ptr<MessageType> skipped;
+            const Slot* slot = conversation->findSlot(index);
+            return slot ? slot->message : skipped;
+        }
+    };
+
+    // Constructor. capacity bounds the number of messages; by default there
+    // is no bound beyond memory.
+    explicit ConcurrentConversation(const std::vector<int>& participants,
+                                    std::size_t capacity = static_cast<std::size_t>(-1))
+        : id(IdGenerator<ConversationIdTag>::next()), limit(capacity), reserved(0), published(0)
+    {
+        if (!members.assign(participants)) {
+            throw FacebookException("Invalid conversation parameters", "ValidationError");
+        }
+        for (auto& segment : segments) {
+            segment.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentConversation(const ConcurrentConversation&) = delete;
+    ConcurrentConversation& operator=(const ConcurrentConversation&) = delete;
+
+    ~ConcurrentConversation() {
+        for (auto& segment : segments) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Getters
+    int getId() const { return id; }
+    const std::vector<int>& getParticipants() const { return members.getParticipants(); }
+    bool isParticipant(int userId) const { return members.contains(userId); }
+    std::size_t capacity() const { return limit; }
+    std::size_t size() const { return published.load(std::memory_order_acquire); }
+
+    // Safe to call from any number of threads at once
+    void addMessage(const std::shared_ptr<MessageType>& message) {
+        if (!message) {
+            throw FacebookException("Message cannot be null", "ValidationError");
+        }
+        if (!members.accepts(message->getSenderId(), message->getReceiverId())) {
+            throw FacebookException("Message sender or receiver is not a participant", "ValidationError");
+        }
+
+        std::size_t index = reserved.fetch_add(1);
+        if (index >= limit) {
+            throw FacebookException("Conversation is full", "CapacityError");
+        }
+        try {
+            Slot& slot = claimSlot(index);
+            message->setSequence(index + 1);
+            slot.message = message;
+            slot.ready.store(true);
+        } catch (...) {
+            skip(index);
+            throw;
+        }
+        publish();
+    }
+
+    // Wait-free: one atomic load
+    Snapshot snapshot() const {
+        return Snapshot(this, published.load(std::memory_order_acquire));
+    }
+};
+
+#endif // CONCURRENT_CONVERSATION_H
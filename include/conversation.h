@@ -1,79 +1,1117 @@
 #ifndef CONVERSATION_H
 #define CONVERSATION_H
 
+#include "clock.h"
+#include "columnar_message_store.h"
+#include "datetime.h"
 #include "facebook_exception.h"
+#include "group_message.h"
+#include "id_generator.h"
+#include "inbox_index.h"
+#include "message_index.h"
+#include "message_segment.h"
+#include "participant_policy.h"
+#include "slab_pool.h"
+#include "span.h"
+#include "timeline.h"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <utility>
+
+// Orders message pointers by timestamp, ties broken by conversation sequence
+struct MessageOrder {
+    template<typename Pointer>
+    bool operator()(const Pointer& a, const Pointer& b) const {
+        return a->getTimestamp() < b->getTimestamp() ||
+               (a->getTimestamp() == b->getTimestamp() && a->getSequence() < b->getSequence());
+    }
+};
+
+// One entry in a conversation's change log, see Conversation::changesSince()
+enum class ChangeType {
+    MessageAdded,  // message was added
+    MessageRead,   // message was marked read by its receiver
+    ReadUpTo       // userId read every message up to and including message
+};
 
 template<typename MessageType>
+struct ConversationChange {
+    uint64_t sequence;
+    ChangeType type;
+    std::shared_ptr<MessageType> message;
+    int userId;  // Receiver for MessageAdded (0 for a group message), reader otherwise
+};
+
+// ParticipantPolicy decides how members are stored: GroupPolicy for any
+// group size, DirectPolicy for two-party conversations.
+template<typename MessageType, typename ParticipantPolicy = GroupPolicy>
 class Conversation {
 private:
     int id;
-    std::vector<int> participants;
-    std::vector<std::shared_ptr<MessageType>> messages;
-    static int nextId;
+    ParticipantPolicy members;
+    Timeline<std::shared_ptr<MessageType>, MessageOrder> messages;
+    uint64_t lastSequence;
 
-    // Validation helpers
-    bool isValidParticipant(int userId) const { return userId > 0; }
-    bool hasValidParticipants() const {
-        return std::all_of(participants.begin(), participants.end(),
-                          [this](int userId) { return isValidParticipant(userId); });
+    // Read tracking for one participant: the messages addressed to them in
+    // timeline order, a watermark (everything before readThrough counts as
+    // read) and the messages after it that were read individually. This,
+    // not Message::isRead(), is what the read queries answer from, so
+    // unreadCount() and getUnreadMessages() always agree.
+    struct ReadState {
+        Timeline<std::shared_ptr<MessageType>, MessageOrder> received;
+        std::size_t readThrough = 0;
+        std::unordered_set<const MessageType*> readAfter;
+
+        std::size_t unread() const { return received.size() - readThrough - readAfter.size(); }
+
+        // Position in received, or received.size() for a message not addressed here
+        std::size_t find(const std::shared_ptr<MessageType>& message) const {
+            auto bounds = std::equal_range(received.begin(), received.end(), message, MessageOrder());
+            auto it = std::find(bounds.first, bounds.second, message);
+            return static_cast<std::size_t>((it != bounds.second ? it : received.end()) - received.begin());
+        }
+    };
+    std::unordered_map<int, ReadState> readStates;
+
+    // Read tracking for group messages, which are stored once rather than
+    // per receiver. Each member has a slot in the messages' bitmaps, kept if
+    // they leave so that older bitmaps stay valid, and a watermark: every
+    // message up to and including it counts as read. Unread messages are
+    // those after the watermark less the member's own and the ones read
+    // individually since (readAfter), so adding a message does no
+    // per-member work beyond copying the recipients bitmap.
+    static constexpr bool groupMessages = IsGroupMessage<MessageType>::value;
+
+    struct GroupReader {
+        std::size_t slot;
+        std::shared_ptr<MessageType> watermark;  // Null until something is read
+        std::size_t readAfter = 0;
+    };
+    struct GroupState {
+        std::unordered_map<int, GroupReader> readers;
+        std::vector<uint64_t> recipients;  // Slots of the current members
+    };
+    struct NoGroupState {};
+    std::conditional_t<groupMessages, GroupState, NoGroupState> group;
+
+    // Give a (re)joining member a slot and start them at the newest message
+    void enrol(int userId) {
+        if constexpr (groupMessages) {
+            auto it = group.readers.try_emplace(userId, GroupReader{group.readers.size(), nullptr, 0}).first;
+            it->second.watermark = messages.empty() ? nullptr : messages.back();
+            it->second.readAfter = 0;
+            setRecipient(it->second.slot, true);
+        }
     }
-    bool hasDuplicateParticipants() const {
-        std::unordered_set<int> uniqueParticipants(participants.begin(), participants.end());
-        return uniqueParticipants.size() != participants.size();
+
+    void setRecipient(std::size_t slot, bool member) {
+        if constexpr (groupMessages) {
+            if (slot / 64 >= group.recipients.size()) {
+                group.recipients.resize(slot / 64 + 1, 0);
+            }
+            uint64_t bit = uint64_t(1) << (slot % 64);
+            if (member) {
+                group.recipients[slot / 64] |= bit;
+            } else {
+                group.recipients[slot / 64] &= ~bit;
+            }
+        }
     }
 
-    // Sort messages by timestamp
-    void sortMessages() {
-        std::sort(messages.begin(), messages.end(),
-                 [](const auto& a, const auto& b) { return a->getTimestamp() < b->getTimestamp(); });
+    const GroupReader* findReader(int userId) const {
+        if constexpr (groupMessages) {
+            auto it = group.readers.find(userId);
+            return it != group.readers.end() && members.contains(userId) ? &it->second : nullptr;
+        } else {
+            return nullptr;
+        }
     }
 
+    // Timeline position of the first message after the reader's watermark
+    std::size_t firstUnread(const GroupReader& reader) const {
+        if (!reader.watermark) {
+            return 0;
+        }
+        auto it = std::upper_bound(messages.begin(), messages.end(), reader.watermark, MessageOrder());
+        return static_cast<std::size_t>(it - messages.begin());
+    }
+
+    // Move userId's watermark to just before timeline position end
+    void readGroupThrough(int userId, std::size_t end) {
+        auto it = group.readers.find(userId);
+        if (it == group.readers.end() || !members.contains(userId)) {
+            return;
+        }
+        GroupReader& reader = it->second;
+        std::size_t from = firstUnread(reader);
+        if (end <= from) {
+            return;
+        }
+        if (end == messages.size()) {
+            reader.readAfter = 0;
+        } else {
+            for (std::size_t i = from; i < end; ++i) {
+                if (messages[i]->isReadBy(reader.slot) && reader.readAfter > 0) {
+                    --reader.readAfter;
+                }
+            }
+        }
+        reader.watermark = messages[end - 1];
+        logChange(ChangeType::ReadUpTo, reader.watermark, userId);
+        notifyUnread(userId);
+    }
+
+    // Messages grouped by sender, each list in timeline order
+    std::unordered_map<int, Timeline<std::shared_ptr<MessageType>, MessageOrder>> sentBy;
+
+    // Messages built by emplaceMessage(), created on first use. Every such
+    // message is handed out as an aliasing shared_ptr that shares the
+    // pool's single control block.
+    std::shared_ptr<SlabPool<MessageType>> ownedMessages;
+
+    // Change log for delta sync, off until enableChangeLog(). The live
+    // entries are changes[changesHead...]; entry changesHead + i has change
+    // sequence firstChange + i, and everything before firstChange was
+    // trimmed, or never kept while the log was off. Trimmed entries are
+    // released at once and compacted away once they outnumber the live ones.
+    std::vector<ConversationChange<MessageType>> changes;
+    std::size_t changesHead = 0;
+    uint64_t firstChange = 1;
+    std::size_t changeLogCapacity = 0;  // Zero while the log is off
+
+    std::size_t liveChanges() const { return changes.size() - changesHead; }
+
+    void logChange(ChangeType type, const std::shared_ptr<MessageType>& message, int userId) {
+        if (changeLogCapacity == 0) {
+            ++firstChange;
+            return;
+        }
+        changes.push_back({firstChange + liveChanges(), type, message, userId});
+        if (liveChanges() > changeLogCapacity) {
+            dropChanges(liveChanges() - changeLogCapacity);
+        }
+    }
+
+    // Drop the oldest count live entries: amortized O(1) each
+    void dropChanges(std::size_t count) {
+        for (std::size_t i = changesHead; i < changesHead + count; ++i) {
+            changes[i].message.reset();
+        }
+        changesHead += count;
+        firstChange += count;
+        if (changesHead >= liveChanges()) {
+            changes.erase(changes.begin(), changes.begin() + changesHead);
+            changesHead = 0;
+        }
+    }
+
+    // Full-text index kept up to date by addMessage(), possibly shared with
+    // other conversations
+    std::shared_ptr<MessageIndex<MessageType>> searchIndex;
+
+    void indexMessage(const std::shared_ptr<MessageType>& message) {
+        if constexpr (HasContent<MessageType>::value) {
+            if (searchIndex) {
+                searchIndex->add(id, message);
+            }
+        }
+    }
+
+    // Inbox kept up to date with this conversation's activity and unread
+    // counts, possibly shared with other conversations
+    std::shared_ptr<InboxIndex> inbox;
+
+    void notifyInbox(int userId) {
+        if (inbox) {
+            inbox->touch(userId, id, messages.empty() ? DateTime(0, 0, 0) : messages.back()->getTimestamp());
+            inbox->setUnread(userId, id, unreadCount(userId));
+        }
+    }
+    void notifyInbox() {
+        if (inbox) {
+            for (int userId : members.getParticipants()) {
+                notifyInbox(userId);
+            }
+        }
+    }
+    void notifyUnread(int userId) {
+        if (inbox) {
+            inbox->setUnread(userId, id, unreadCount(userId));
+        }
+    }
+    // After an add: move the conversation up every member's inbox when the
+    // newest message changed, and refresh only the unread counts the add
+    // can have changed, the receiver's for a Message
+    void notifyAdded(const std::shared_ptr<MessageType>& message) {
+        if (!inbox) {
+            return;
+        }
+        if (messages.back() == message) {
+            for (int userId : members.getParticipants()) {
+                inbox->touch(userId, id, message->getTimestamp());
+            }
+        }
+        if constexpr (groupMessages) {
+            for (int userId : members.getParticipants()) {
+                if (userId != message->getSenderId()) {
+                    notifyUnread(userId);
+                }
+            }
+        } else {
+            notifyUnread(message->getReceiverId());
+        }
+    }
+
+    // Columnar copy of the resident timeline's metadata, see
+    // enableColumnarStore(). Position i describes messages[i].
+    std::optional<ColumnarMessageStore> columns;
+
+    // Refill the columns after a change that moves many positions at once
+    void rebuildColumns() {
+        if constexpr (!groupMessages) {
+            if (!columns) {
+                return;
+            }
+            columns->clear();
+            columns->reserve(messages.size());
+            for (std::size_t i = 0; i < messages.size(); ++i) {
+                columns->insert(i, *messages[i], isSettled(messages[i]));
+            }
+        }
+    }
+
+    // Cold tier, see enableColdTier(). segments holds spilled history,
+    // oldest first. The newest pagedIn of them are decoded back into the
+    // timeline, with their copies listed in loaded.
+    struct ColdTier {
+        bool enabled = false;
+        std::size_t keepResident = 0;
+        std::size_t segmentSize = 0;
+        int64_t maxAgeSeconds = 0;
+        std::string directory;
+        std::vector<std::shared_ptr<MessageSegment>> segments;
+        std::vector<std::vector<std::shared_ptr<MessageType>>> loaded;
+        std::size_t pagedIn = 0;
+        std::size_t messageCount = 0;
+        std::string error;           // Why the last spill after an add failed
+        std::size_t retryAt = 0;     // Resident size at which to try again
+        std::size_t backoff = 0;     // Adds to wait after the next failure
+    } cold;
+
+    static constexpr bool spillable =
+        HasContent<MessageType>::value &&
+        std::is_constructible<MessageType, int, int, const std::string&, const DateTime&>::value;
+
+    // Read by its receiver, individually or through their watermark
+    bool isSettled(const std::shared_ptr<MessageType>& message) const {
+        auto it = readStates.find(message->getReceiverId());
+        if (it == readStates.end()) {
+            return false;
+        }
+        const ReadState& state = it->second;
+        return (state.readThrough > 0 && !MessageOrder()(state.received[state.readThrough - 1], message)) ||
+               state.readAfter.count(message.get()) > 0;
+    }
+
+    // Write the oldest count messages to a new segment and drop them from
+    // the timeline and the per-sender and per-receiver indexes, where they
+    // are a prefix too
+    void spill(std::size_t count) {
+        std::vector<std::shared_ptr<MessageType>> spilled(messages.begin(), messages.begin() + count);
+        for (const auto& message : spilled) {
+            message->markAsRead();  // Settled, possibly only through a watermark
+        }
+        // IDs are per process, so the process tag keeps names unique in a
+        // directory that several processes share
+        std::string path = cold.directory + "/conversation-" + MessageSegment::processTag() + "-" +
+                           std::to_string(id) + "-" + std::to_string(IdGenerator<MessageSegment>::next()) + ".seg";
+        cold.segments.push_back(MessageSegment::write(path, spilled));
+        cold.loaded.emplace_back();
+        cold.messageCount += count;
+
+        messages.eraseFront(count);
+        if (columns) {
+            columns->eraseFront(count);
+        }
+        std::unordered_map<int, std::size_t> bySender;
+        std::unordered_map<int, std::size_t> byReceiver;
+        for (const auto& message : spilled) {
+            ++bySender[message->getSenderId()];
+            ++byReceiver[message->getReceiverId()];
+            readStates[message->getReceiverId()].readAfter.erase(message.get());
+        }
+        for (const auto& [senderId, sent] : bySender) {
+            sentBy[senderId].eraseFront(sent);
+        }
+        for (const auto& [receiverId, received] : byReceiver) {
+            ReadState& state = readStates[receiverId];
+            state.received.eraseFront(received);
+            state.readThrough = state.readThrough > received ? state.readThrough - received : 0;
+        }
+    }
+
+    void evictOldestPagedIn() {
+        std::size_t index = cold.segments.size() - cold.pagedIn;
+        std::unordered_set<const MessageType*> copies;
+        for (const auto& message : cold.loaded[index]) {
+            copies.insert(message.get());
+        }
+        auto isCopy = [&copies](const auto& message) { return copies.count(message.get()) > 0; };
+        messages.eraseIf(isCopy);
+
+        // Every copy is settled: read individually or behind the watermark
+        std::unordered_map<int, std::size_t> behind;
+        for (const auto& message : cold.loaded[index]) {
+            sentBy[message->getSenderId()].eraseIf(isCopy);
+            ReadState& state = readStates[message->getReceiverId()];
+            if (state.readAfter.erase(message.get()) == 0) {
+                ++behind[message->getReceiverId()];
+            }
+        }
+        for (auto& [receiverId, state] : readStates) {
+            state.received.eraseIf(isCopy);
+            auto it = behind.find(receiverId);
+            state.readThrough -= it != behind.end() ? std::min(it->second, state.readThrough) : 0;
+        }
+        cold.loaded[index] = {};
+        --cold.pagedIn;
+        rebuildColumns();
+    }
+
+    // Decode the newest segment that is not paged in back into the timeline
+    bool pageInOlder() {
+        if constexpr (spillable) {
+            if (cold.pagedIn == cold.segments.size()) {
+                return false;
+            }
+            std::size_t index = cold.segments.size() - cold.pagedIn - 1;
+            const MessageSegment& segment = *cold.segments[index];
+            std::vector<std::shared_ptr<MessageType>>& copies = cold.loaded[index];
+            copies.reserve(segment.size());
+            for (std::size_t i = 0; i < segment.size(); ++i) {
+                StoredMessage stored = segment.at(i);
+                auto message = std::make_shared<MessageType>(stored.senderId, stored.receiverId,
+                                                             std::string(stored.content), stored.timestamp);
+                message->setSequence(stored.sequence);
+                if (stored.read) {
+                    message->markAsRead();
+                }
+                copies.push_back(std::move(message));
+            }
+            segment.unmap();
+            messages.merge(copies);
+
+            // Index the copies like any other message. They were settled to
+            // be spilled, so each is read for its receiver.
+            std::unordered_map<int, std::vector<std::shared_ptr<MessageType>>> bySender;
+            std::unordered_map<int, std::vector<std::shared_ptr<MessageType>>> byReceiver;
+            for (const auto& message : copies) {
+                bySender[message->getSenderId()].push_back(message);
+                byReceiver[message->getReceiverId()].push_back(message);
+            }
+            for (const auto& [senderId, sent] : bySender) {
+                sentBy[senderId].merge(sent);
+            }
+            for (const auto& [receiverId, received] : byReceiver) {
+                ReadState& state = readStates[receiverId];
+                std::size_t behind = 0;
+                for (const auto& message : received) {
+                    if (state.readThrough > 0 && MessageOrder()(message, state.received[state.readThrough - 1])) {
+                        ++behind;
+                    } else {
+                        state.readAfter.insert(message.get());
+                    }
+                }
+                state.received.merge(received);
+                state.readThrough += behind;
+            }
+            ++cold.pagedIn;
+            rebuildColumns();
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    // Whether the next segment to page in holds messages at or after time.
+    // Segments are paged in newest first, so once this fails no older one
+    // reaches time either.
+    bool coldHasAtOrAfter(const DateTime& time) const {
+        return cold.pagedIn < cold.segments.size() &&
+               !(cold.segments[cold.segments.size() - cold.pagedIn - 1]->getNewest() < time);
+    }
+
+    // Spill after an add. The message is already in; a failed write keeps
+    // history resident and is recorded in getColdTierError(). Each failure
+    // doubles the number of adds before the next attempt, so a broken
+    // directory does not cost a segment encode per add.
+    void maybeSpill() {
+        if (!cold.enabled || messages.size() < cold.retryAt) {
+            return;
+        }
+        try {
+            spillColdHistory();
+            cold.error.clear();
+            cold.retryAt = 0;
+            cold.backoff = cold.segmentSize;
+        } catch (const FacebookException& e) {
+            cold.error = e.what();
+            cold.retryAt = messages.size() + cold.backoff;
+            cold.backoff *= 2;
+        }
+    }
+
+    // First timeline position whose timestamp is not before / is after time
+    std::size_t firstAtOrAfter(const DateTime& time) const {
+        auto it = std::lower_bound(messages.begin(), messages.end(), time,
+                                   [](const auto& msg, const DateTime& t) { return msg->getTimestamp() < t; });
+        return static_cast<std::size_t>(it - messages.begin());
+    }
+    std::size_t firstAfter(const DateTime& time) const {
+        auto it = std::upper_bound(messages.begin(), messages.end(), time,
+                                   [](const DateTime& t, const auto& msg) { return t < msg->getTimestamp(); });
+        return static_cast<std::size_t>(it - messages.begin());
+    }
+    Span<std::shared_ptr<MessageType>> range(std::size_t from, std::size_t to) const {
+        return Span<std::shared_ptr<MessageType>>(messages.getItems()).subspan(from, to > from ? to - from : 0);
+    }
+    // Up to limit messages from position from; clamped, so any limit is safe
+    Span<std::shared_ptr<MessageType>> rangeFrom(std::size_t from, std::size_t limit) const {
+        return Span<std::shared_ptr<MessageType>>(messages.getItems()).subspan(from, limit);
+    }
+
+    // Validation helpers
+    bool isValidParticipant(int userId) const { return userId > 0; }
+
 public:
     // Constructor
     explicit Conversation(const std::vector<int>& participants)
-        : id(nextId++), participants(participants)
+        : id(IdGenerator<ConversationIdTag>::next()), lastSequence(0)
     {
-        if (!hasValidParticipants() || hasDuplicateParticipants()) {
+        if (!members.assign(participants)) {
             throw FacebookException("Invalid conversation parameters", "ValidationError");
         }
+        for (int userId : members.getParticipants()) {
+            enrol(userId);
+        }
     }
     
     // Getters
     int getId() const { return id; }
-    const std::vector<int>& getParticipants() const { return participants; }
-    const std::vector<std::shared_ptr<MessageType>>& getMessages() const { return messages; }
+    decltype(auto) getParticipants() const { return members.getParticipants(); }
+    const std::vector<std::shared_ptr<MessageType>>& getMessages() const { return messages.getItems(); }
+    uint64_t getLastSequence() const { return lastSequence; }
     
     // Message management
+    
+    // Build a message inside the conversation's slabs and add it. Costs no
+    // per-message allocation for the object or its control block, keeps
+    // history contiguous, and releases it all at once with the conversation
+    // (or the last outstanding handle).
+    template<typename... Args>
+    std::shared_ptr<MessageType> emplaceMessage(Args&&... args) {
+        if (!ownedMessages) {
+            ownedMessages = std::make_shared<SlabPool<MessageType>>();
+        }
+        MessageType* message = ownedMessages->emplace(std::forward<Args>(args)...);
+        std::shared_ptr<MessageType> handle(ownedMessages, message);
+        try {
+            addMessage(handle);
+        } catch (...) {
+            ownedMessages->popBack();
+            throw;
+        }
+        return handle;
+    }
+
     void addMessage(const std::shared_ptr<MessageType>& message) {
         if (!message) {
             throw FacebookException("Message cannot be null", "ValidationError");
         }
-        if (!isParticipant(message->getSenderId()) || !isParticipant(message->getReceiverId())) {
-            throw FacebookException("Message sender or receiver is not a participant", "ValidationError");
+        if constexpr (groupMessages) {
+            const GroupReader* sender = findReader(message->getSenderId());
+            if (!sender) {
+                throw FacebookException("Message sender is not a participant", "ValidationError");
+            }
+            message->deliver(group.recipients, sender->slot);
+            message->setSequence(++lastSequence);
+            messages.insert(message);
+            indexMessage(message);
+            logChange(ChangeType::MessageAdded, message, 0);
+            sentBy[message->getSenderId()].insert(message);
+        } else {
+            if (!members.accepts(message->getSenderId(), message->getReceiverId())) {
+                throw FacebookException("Message sender or receiver is not a participant", "ValidationError");
+            }
+            message->setSequence(++lastSequence);
+            std::size_t position = messages.insert(message);  // O(1) when messages arrive in order
+            indexMessage(message);
+            logChange(ChangeType::MessageAdded, message, message->getReceiverId());
+
+            sentBy[message->getSenderId()].insert(message);
+
+            ReadState& state = readStates[message->getReceiverId()];
+            if (state.received.insert(message) < state.readThrough) {
+                ++state.readThrough;  // Arrived late, behind what the receiver already read
+            } else if (message->isRead()) {
+                state.readAfter.insert(message.get());
+            }
+            if (columns) {
+                columns->insert(position, *message, isSettled(message));
+            }
+        }
+        notifyAdded(message);
+        maybeSpill();
+    }
+    
+    // Bound resident memory by moving old history to disk. Once enabled, read
+    // messages beyond the newest keepResident (or, when maxAgeSeconds is set,
+    // sent longer ago than that) are written to immutable segment files in
+    // directory, segmentSize or more at a time, and released. Unread
+    // messages always stay resident so read tracking stays exact.
+    //
+    // getMessages(), getMessagesByUser() and const reads see resident
+    // messages only; the non-const paginated reads page segments back in.
+    // Paged-in messages count as resident, in every index and as read,
+    // until the next add evicts them again.
+    // An enabled change log (up to its capacity) and an attached index keep
+    // their own references, so trimChanges() them to release spilled
+    // messages fully. Messages built by emplaceMessage() are freed only
+    // with their slab.
+    void enableColdTier(std::size_t keepResident, std::size_t segmentSize = 1024, int64_t maxAgeSeconds = 0,
+                        const std::string& directory = FileManager::getInstance().getSegmentsDirectory()) {
+        static_assert(spillable, "Cold tier needs getContent() and a (sender, receiver, content, timestamp) constructor");
+        if (segmentSize == 0) {
+            throw FacebookException("Segment size must be positive", "ValidationError");
+        }
+        cold.enabled = true;
+        cold.keepResident = keepResident;
+        cold.segmentSize = segmentSize;
+        cold.maxAgeSeconds = maxAgeSeconds;
+        cold.directory = directory;
+        cold.error.clear();
+        cold.retryAt = 0;
+        cold.backoff = segmentSize;
+        spillColdHistory();
+    }
+
+    // Spill now rather than on the next add; throws FileError if the
+    // segment cannot be written
+    void spillColdHistory() {
+        if constexpr (spillable) {
+            if (!cold.enabled) {
+                return;
+            }
+            // Paged-in history goes first: it is already on disk
+            while (cold.pagedIn > 0 && messages.size() > cold.keepResident) {
+                evictOldestPagedIn();
+            }
+            if (cold.pagedIn > 0) {
+                return;
+            }
+
+            std::size_t count = messages.size() > cold.keepResident ? messages.size() - cold.keepResident : 0;
+            if (cold.maxAgeSeconds > 0) {
+                int64_t cutoff = Clock::getInstance().now().toEpochSeconds() - cold.maxAgeSeconds;
+                auto expired = std::partition_point(messages.begin(), messages.end(), [cutoff](const auto& msg) {
+                    return msg->getTimestamp().toEpochSeconds() < cutoff;
+                });
+                count = std::max(count, static_cast<std::size_t>(expired - messages.begin()));
+            }
+            std::size_t settled = 0;
+            while (settled < count && isSettled(messages[settled])) {
+                ++settled;
+            }
+            if (settled >= cold.segmentSize) {
+                spill(settled);
+            }
+        }
+    }
+
+    std::size_t getColdMessageCount() const { return cold.messageCount; }
+    std::size_t getColdSegmentCount() const { return cold.segments.size(); }
+
+    // Why the last spill after an add failed; empty once one succeeds
+    const std::string& getColdTierError() const { return cold.error; }
+
+    // Keep a ColumnarMessageStore of the resident messages' sender,
+    // receiver, timestamp and read state, for filters that scan columns
+    // instead of following a pointer per message. Its positions match
+    // getMessages(); a message counts as read there once it is read or
+    // behind its receiver's watermark. Each add then also inserts into the
+    // columns, and paging cold history in or out rebuilds them.
+    void enableColumnarStore() {
+        static_assert(!groupMessages, "Group messages are read per member, which one read column cannot hold");
+        if (!columns) {
+            columns.emplace();
+            rebuildColumns();
+        }
+    }
+
+    // Null until enableColumnarStore()
+    const ColumnarMessageStore* getColumnarStore() const { return columns ? &*columns : nullptr; }
+
+    // Messages at the positions set in a bitmap from the columnar store
+    std::vector<std::shared_ptr<MessageType>> getMessagesAt(const PositionBitmap& bitmap) const {
+        std::vector<std::shared_ptr<MessageType>> selected;
+        selected.reserve(ColumnarMessageStore::countMatches(bitmap));
+        for (std::size_t position : ColumnarMessageStore::positions(bitmap)) {
+            if (position < messages.size()) {
+                selected.push_back(messages[position]);
+            }
+        }
+        return selected;
+    }
+
+    // Index this conversation's messages, current and future, in index.
+    // One index can serve many conversations; search it scoped to the
+    // conversation IDs a user belongs to.
+    void attachIndex(const std::shared_ptr<MessageIndex<MessageType>>& index) {
+        static_assert(HasContent<MessageType>::value, "Search needs MessageType::getContent()");
+        if (index == searchIndex) {
+            return;
+        }
+        searchIndex = index;
+        for (const auto& message : messages) {
+            indexMessage(message);
+        }
+    }
+
+    // A message addMessages() left out: its index in the batch and the
+    // message addMessage() would have thrown with
+    struct Rejection {
+        std::size_t index;
+        std::string reason;
+    };
+
+    // List this conversation in every participant's inbox and keep the
+    // entries' activity time and unread counts current from now on. One
+    // index usually serves all of a store's conversations.
+    void attachInbox(const std::shared_ptr<InboxIndex>& index) {
+        if (index == inbox) {
+            return;
+        }
+        inbox = index;
+        notifyInbox();
+    }
+
+    // Add a batch of messages, e.g. when importing history. Participants are
+    // checked once per distinct sender/receiver pair, the accepted messages
+    // are sorted once and merged into each timeline in a single linear pass.
+    // Invalid messages are skipped and reported instead of thrown.
+    // Sequences follow batch order, as if each message were added in turn.
+    std::vector<Rejection> addMessages(const std::vector<std::shared_ptr<MessageType>>& batch) {
+        std::vector<Rejection> rejected;
+        if constexpr (groupMessages) {
+            // No per-receiver timelines to merge into: add one at a time
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                if (!batch[i]) {
+                    rejected.push_back({i, "Message cannot be null"});
+                } else if (!findReader(batch[i]->getSenderId())) {
+                    rejected.push_back({i, "Message sender is not a participant"});
+                } else {
+                    addMessage(batch[i]);
+                }
+            }
+            return rejected;
+        } else {
+            std::vector<std::shared_ptr<MessageType>> accepted;
+            accepted.reserve(batch.size());
+            std::unordered_map<uint64_t, bool> pairAccepted;
+            uint64_t lastPair = 0;  // Users 0 and 0 never form a valid pair
+            bool lastAccepted = false;
+            bool sorted = true;
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                const auto& message = batch[i];
+                if (!message) {
+                    rejected.push_back({i, "Message cannot be null"});
+                    continue;
+                }
+                uint64_t pair = static_cast<uint64_t>(static_cast<uint32_t>(message->getSenderId())) << 32 |
+                                static_cast<uint32_t>(message->getReceiverId());
+                if (pair != lastPair) {
+                    auto cached = pairAccepted.find(pair);
+                    if (cached == pairAccepted.end()) {
+                        cached = pairAccepted.emplace(pair, members.accepts(message->getSenderId(),
+                                                                            message->getReceiverId())).first;
+                    }
+                    lastPair = pair;
+                    lastAccepted = cached->second;
+                }
+                if (!lastAccepted) {
+                    rejected.push_back({i, "Message sender or receiver is not a participant"});
+                    continue;
+                }
+                message->setSequence(++lastSequence);
+                sorted = sorted && (accepted.empty() || !MessageOrder()(message, accepted.back()));
+                accepted.push_back(message);
+                indexMessage(message);
+                logChange(ChangeType::MessageAdded, message, message->getReceiverId());
+            }
+            if (accepted.empty()) {
+                return rejected;
+            }
+
+            if (!sorted) {
+                std::sort(accepted.begin(), accepted.end(), MessageOrder());
+            }
+            std::size_t resident = messages.size();
+            bool appended = messages.empty() || !MessageOrder()(accepted.front(), messages.back());
+            messages.merge(accepted);
+
+            // Per-sender and per-receiver timelines: messages newer than the tail
+            // are appended right away, older ones are merged per key afterwards
+            std::unordered_map<int, std::vector<std::shared_ptr<MessageType>>> lateSent;
+            std::unordered_map<int, std::vector<std::shared_ptr<MessageType>>> lateReceived;
+            for (const auto& message : accepted) {
+                auto& sent = sentBy[message->getSenderId()];
+                if (sent.empty() || !MessageOrder()(message, sent.back())) {
+                    sent.insert(message);
+                } else {
+                    lateSent[message->getSenderId()].push_back(message);
+                }
+
+                ReadState& state = readStates[message->getReceiverId()];
+                if (state.received.empty() || !MessageOrder()(message, state.received.back())) {
+                    state.received.insert(message);
+                    if (message->isRead()) {
+                        state.readAfter.insert(message.get());
+                    }
+                } else {
+                    lateReceived[message->getReceiverId()].push_back(message);
+                }
+            }
+            for (const auto& [senderId, late] : lateSent) {
+                sentBy[senderId].merge(late);
+            }
+            for (const auto& [receiverId, late] : lateReceived) {
+                ReadState& state = readStates[receiverId];
+                // Messages sorting before the last one read land behind the watermark
+                std::size_t behind = 0;
+                for (const auto& message : late) {
+                    if (state.readThrough > 0 && MessageOrder()(message, state.received[state.readThrough - 1])) {
+                        ++behind;
+                    } else if (message->isRead()) {
+                        state.readAfter.insert(message.get());
+                    }
+                }
+                state.received.merge(late);
+                state.readThrough += behind;
+            }
+            if (columns && appended) {
+                for (std::size_t i = resident; i < messages.size(); ++i) {
+                    columns->insert(i, *messages[i], isSettled(messages[i]));
+                }
+            } else {
+                rebuildColumns();
+            }
+            if (inbox) {
+                for (int userId : members.getParticipants()) {
+                    inbox->touch(userId, id, messages.back()->getTimestamp());
+                }
+                std::unordered_set<int> receivers;
+                for (const auto& message : accepted) {
+                    if (receivers.insert(message->getReceiverId()).second) {
+                        notifyUnread(message->getReceiverId());
+                    }
+                }
+            }
+            maybeSpill();
+            return rejected;
         }
-        messages.push_back(message);
-        sortMessages();  // Sort messages after adding new one
     }
     
-    std::vector<std::shared_ptr<MessageType>> getMessagesByUser(int userId) const {
-        std::vector<std::shared_ptr<MessageType>> userMessages;
-        std::copy_if(messages.begin(), messages.end(), std::back_inserter(userMessages),
-                     [userId](const auto& msg) { return msg->getSenderId() == userId; });
-        return userMessages;
+    // Paginated and time-window views over the timeline, answered by binary
+    // search. Like getMessagesByUser() they stay valid until the next
+    // addMessage; positions index into getMessages().
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    std::size_t positionOf(const std::shared_ptr<MessageType>& message) const {
+        if (!message) {
+            return npos;
+        }
+        auto bounds = std::equal_range(messages.begin(), messages.end(), message, MessageOrder());
+        auto it = std::find(bounds.first, bounds.second, message);
+        return it != bounds.second ? static_cast<std::size_t>(it - messages.begin()) : npos;
+    }
+
+    Span<std::shared_ptr<MessageType>> getLatestMessages(std::size_t limit) const {
+        return getMessagesBefore(messages.size(), limit);
+    }
+
+    // Up to limit messages immediately before / after a position
+    Span<std::shared_ptr<MessageType>> getMessagesBefore(std::size_t position, std::size_t limit) const {
+        position = std::min(position, messages.size());
+        return range(position > limit ? position - limit : 0, position);
+    }
+    Span<std::shared_ptr<MessageType>> getMessagesAfter(std::size_t position, std::size_t limit) const {
+        return position == npos ? Span<std::shared_ptr<MessageType>>() : rangeFrom(position + 1, limit);
+    }
+
+    // Up to limit messages sent strictly before / after a time
+    Span<std::shared_ptr<MessageType>> getMessagesBefore(const DateTime& time, std::size_t limit) const {
+        return getMessagesBefore(firstAtOrAfter(time), limit);
+    }
+    Span<std::shared_ptr<MessageType>> getMessagesAfter(const DateTime& time, std::size_t limit) const {
+        return rangeFrom(firstAfter(time), limit);
+    }
+
+    // Messages sent at or after from and before to
+    Span<std::shared_ptr<MessageType>> getMessagesBetween(const DateTime& from, const DateTime& to) const {
+        return range(firstAtOrAfter(from), firstAtOrAfter(to));
+    }
+
+    // The same reads on a non-const Conversation first page cold history
+    // back in, a segment at a time, when they reach past the oldest resident
+    // message. Positions shift by the number of messages paged in.
+    Span<std::shared_ptr<MessageType>> getLatestMessages(std::size_t limit) {
+        while (messages.size() < limit && pageInOlder()) {
+        }
+        return std::as_const(*this).getLatestMessages(limit);
+    }
+    Span<std::shared_ptr<MessageType>> getMessagesBefore(std::size_t position, std::size_t limit) {
+        position = std::min(position, messages.size());
+        while (position < limit) {
+            std::size_t before = messages.size();
+            if (!pageInOlder()) {
+                break;
+            }
+            position += messages.size() - before;
+        }
+        return std::as_const(*this).getMessagesBefore(position, limit);
+    }
+    Span<std::shared_ptr<MessageType>> getMessagesBefore(const DateTime& time, std::size_t limit) {
+        // A segment wholly at or after time may still have older ones behind it
+        while (firstAtOrAfter(time) < limit && pageInOlder()) {
+        }
+        return std::as_const(*this).getMessagesBefore(time, limit);
+    }
+    Span<std::shared_ptr<MessageType>> getMessagesBetween(const DateTime& from, const DateTime& to) {
+        while (coldHasAtOrAfter(from) && pageInOlder()) {
+        }
+        return std::as_const(*this).getMessagesBetween(from, to);
+    }
+
+    // Messages sent by a user in timeline order, valid until the next addMessage
+    Span<std::shared_ptr<MessageType>> getMessagesByUser(int userId) const {
+        auto it = sentBy.find(userId);
+        if (it == sentBy.end()) {
+            return Span<std::shared_ptr<MessageType>>();
+        }
+        return Span<std::shared_ptr<MessageType>>(it->second.getItems());
     }
     
     std::vector<std::shared_ptr<MessageType>> getUnreadMessages(int userId) const {
         std::vector<std::shared_ptr<MessageType>> unreadMessages;
-        std::copy_if(messages.begin(), messages.end(), std::back_inserter(unreadMessages),
-                     [userId](const auto& msg) { 
-                         return msg->getReceiverId() == userId && !msg->isRead(); 
-                     });
+        if constexpr (groupMessages) {
+            const GroupReader* reader = findReader(userId);
+            if (!reader) {
+                return unreadMessages;
+            }
+            std::size_t slot = reader->slot;
+            std::copy_if(messages.begin() + firstUnread(*reader), messages.end(), std::back_inserter(unreadMessages),
+                         [slot](const auto& msg) { return msg->isDeliveredTo(slot) && !msg->isReadBy(slot); });
+        } else {
+            auto it = readStates.find(userId);
+            if (it == readStates.end()) {
+                return unreadMessages;
+            }
+            const ReadState& state = it->second;
+            std::copy_if(state.received.begin() + state.readThrough, state.received.end(),
+                         std::back_inserter(unreadMessages),
+                         [&state](const auto& msg) { return state.readAfter.count(msg.get()) == 0; });
+        }
         return unreadMessages;
     }
+
+    // Read state. Only reads made through the Conversation count: mark
+    // messages read with markAsRead() here, not on the message directly,
+    // which would leave the conversation treating them as unread.
+    std::size_t unreadCount(int userId) const {
+        if constexpr (groupMessages) {
+            // O(log n): messages after the watermark, less the user's own
+            // and the ones they read individually
+            const GroupReader* reader = findReader(userId);
+            if (!reader) {
+                return 0;
+            }
+            std::size_t after = messages.size() - firstUnread(*reader);
+            auto sent = sentBy.find(userId);
+            if (sent != sentBy.end() && reader->watermark) {
+                const auto& own = sent->second;
+                after -= static_cast<std::size_t>(
+                    own.end() - std::upper_bound(own.begin(), own.end(), reader->watermark, MessageOrder()));
+            } else if (sent != sentBy.end()) {
+                after -= sent->second.size();
+            }
+            return after > reader->readAfter ? after - reader->readAfter : 0;
+        } else {
+            auto it = readStates.find(userId);
+            return it != readStates.end() ? it->second.unread() : 0;
+        }
+    }
+
+    // Group messages: read by userId, individually or through their watermark
+    bool isReadBy(const std::shared_ptr<MessageType>& message, int userId) const {
+        static_assert(groupMessages, "isReadBy() is for group messages; use Message::isRead()");
+        const GroupReader* reader = findReader(userId);
+        if (!message || !reader || !message->isDeliveredTo(reader->slot)) {
+            return false;
+        }
+        return message->isReadBy(reader->slot) ||
+               (reader->watermark && !MessageOrder()(reader->watermark, message));
+    }
+
+    // Group messages: mark read for one member. O(log n) to find the
+    // message, plus the bitmap lookup.
+    void markAsRead(const std::shared_ptr<MessageType>& message, int userId) {
+        static_assert(groupMessages, "markAsRead(message, userId) is for group messages");
+        const GroupReader* found = findReader(userId);
+        if (!message || !found) {
+            return;
+        }
+        // Slots are per conversation, so a foreign message's bitmap means nothing here
+        if (positionOf(message) == npos) {
+            throw FacebookException("Message is not in this conversation", "ValidationError");
+        }
+        if (!message->markReadBy(found->slot)) {
+            return;
+        }
+        GroupReader& reader = group.readers.at(userId);
+        logChange(ChangeType::MessageRead, message, userId);
+        if (!reader.watermark || MessageOrder()(reader.watermark, message)) {
+            ++reader.readAfter;
+        }
+        notifyUnread(userId);
+    }
+
+    void markAsRead(const std::shared_ptr<MessageType>& message) {
+        static_assert(!groupMessages, "Group messages are read per member: use markAsRead(message, userId)");
+        if (!message) {
+            return;
+        }
+        std::size_t position = positionOf(message);
+        if (position == npos) {
+            throw FacebookException("Message is not in this conversation", "ValidationError");
+        }
+        ReadState& state = readStates[message->getReceiverId()];
+        std::size_t index = state.find(message);
+        if (index == state.received.size() || index < state.readThrough ||
+            !state.readAfter.insert(message.get()).second) {
+            return;
+        }
+        message->markAsRead();
+        logChange(ChangeType::MessageRead, message, message->getReceiverId());
+        if (columns) {
+            columns->markAsRead(position);
+        }
+        notifyUnread(message->getReceiverId());
+    }
+
+    // Move the watermark to the newest message: O(1) plus the messages read
+    // individually since the last move, or a scan of the receiver column
+    // with the columnar store enabled
+    void markAllAsRead(int userId) {
+        if constexpr (groupMessages) {
+            readGroupThrough(userId, messages.size());
+        } else {
+            auto it = readStates.find(userId);
+            if (it == readStates.end() || it->second.readThrough == it->second.received.size()) {
+                return;
+            }
+            it->second.readThrough = it->second.received.size();
+            it->second.readAfter.clear();
+            if (columns) {
+                columns->markReadBy(userId, columns->size());
+            }
+            logChange(ChangeType::ReadUpTo, it->second.received.back(), userId);
+            notifyUnread(userId);
+        }
+    }
+
+    // Move the watermark past every message sent at or before the given
+    // time: O(log n), plus the newly covered messages unless that is all
+    void markReadUpTo(int userId, const DateTime& time) {
+        if constexpr (groupMessages) {
+            readGroupThrough(userId, firstAfter(time));
+        } else {
+            auto it = readStates.find(userId);
+            if (it == readStates.end()) {
+                return;
+            }
+            ReadState& state = it->second;
+            auto end = std::upper_bound(state.received.begin() + state.readThrough, state.received.end(), time,
+                                        [](const DateTime& t, const auto& msg) { return t < msg->getTimestamp(); });
+            if (end == state.received.end()) {
+                markAllAsRead(userId);
+                return;
+            }
+            if (end == state.received.begin() + state.readThrough) {
+                return;
+            }
+            for (auto msg = state.received.begin() + state.readThrough; msg != end; ++msg) {
+                state.readAfter.erase(msg->get());
+            }
+            state.readThrough = static_cast<std::size_t>(end - state.received.begin());
+            if (columns) {
+                columns->markReadBy(userId, firstAfter(time));
+            }
+            logChange(ChangeType::ReadUpTo, state.received[state.readThrough - 1], userId);
+            notifyUnread(userId);
+        }
+    }
+
+    // Delta sync. Every added message and every read made through the
+    // Conversation gets the next change sequence. A client keeps the
+    // cursor from its last sync and asks only for what came after it.
+    // Changes are only kept once enableChangeLog() is called, at most
+    // capacity of them: a client further behind gets fullResync.
+    static constexpr std::size_t DEFAULT_CHANGE_LOG_CAPACITY = 65536;
+
+    void enableChangeLog(std::size_t capacity = DEFAULT_CHANGE_LOG_CAPACITY) {
+        if (capacity == 0) {
+            throw FacebookException("Change log capacity must be positive", "ValidationError");
+        }
+        changeLogCapacity = capacity;
+        if (liveChanges() > capacity) {
+            dropChanges(liveChanges() - capacity);
+        }
+    }
+    struct ChangeSet {
+        Span<ConversationChange<MessageType>> changes;  // Valid until the next change
+        uint64_t cursor;   // Pass to the next changesSince()
+        bool fullResync;   // Changes after the old cursor were trimmed: re-read getMessages()
+    };
+
+    uint64_t getChangeSequence() const { return firstChange + liveChanges() - 1; }
+
+    // O(1): change sequences are dense, so the cursor indexes the log
+    ChangeSet changesSince(uint64_t cursor) const {
+        uint64_t latest = getChangeSequence();
+        if (cursor + 1 < firstChange) {
+            return {Span<ConversationChange<MessageType>>(), latest, true};
+        }
+        std::size_t from = static_cast<std::size_t>(std::min(cursor + 1, latest + 1) - firstChange);
+        return {Span<ConversationChange<MessageType>>(changes.data() + changesHead + from, liveChanges() - from),
+                latest, false};
+    }
+
+    // Drop log entries up to and including cursor once every client has
+    // synced past it; clients still behind it get fullResync
+    void trimChanges(uint64_t cursor) {
+        if (cursor < firstChange) {
+            return;
+        }
+        dropChanges(static_cast<std::size_t>(std::min<uint64_t>(cursor - firstChange + 1, liveChanges())));
+    }
     
     // Participant management
     void addParticipant(int userId) {
@@ -83,28 +1121,34 @@ public:
         if (isParticipant(userId)) {
             throw FacebookException("User is already a participant", "ValidationError");
         }
-        participants.push_back(userId);
+        if (!members.add(userId)) {
+            throw FacebookException("Conversation cannot take more participants", "ValidationError");
+        }
+        enrol(userId);
+        notifyInbox(userId);
     }
     
     void removeParticipant(int userId) {
-        auto it = std::find(participants.begin(), participants.end(), userId);
-        if (it != participants.end()) {
-            participants.erase(it);
+        members.remove(userId);
+        if constexpr (groupMessages) {
+            auto it = group.readers.find(userId);
+            if (it != group.readers.end()) {
+                setRecipient(it->second.slot, false);
+            }
+        }
+        if (inbox) {
+            inbox->remove(userId, id);
         }
     }
     
     bool isParticipant(int userId) const {
-        return std::find(participants.begin(), participants.end(), userId) != participants.end();
+        return members.contains(userId);
     }
     
     // Comparison operators
-    bool operator<(const Conversation<MessageType>& other) const { return id < other.id; }
-    bool operator>(const Conversation<MessageType>& other) const { return id > other.id; }
-    bool operator==(const Conversation<MessageType>& other) const { return id == other.id; }
+    bool operator<(const Conversation& other) const { return id < other.id; }
+    bool operator>(const Conversation& other) const { return id > other.id; }
+    bool operator==(const Conversation& other) const { return id == other.id; }
 };
 
-// Initialize static member
-template<typename MessageType>
-int Conversation<MessageType>::nextId = 1;
-
 #endif // CONVERSATION_H
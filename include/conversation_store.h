@@ -0,0 +1,82 @@
+#ifndef CONVERSATION_STORE_H
+#define CONVERSATION_STORE_H
+
+#include "conversation.h"
+#include "facebook_exception.h"
+#include "inbox_index.h"
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Owns a set of conversations by ID and keeps every user's inbox: their
+// conversations, most recently active first, with unread counts. Each
+// conversation reports to the shared InboxIndex as messages are added or
+// read, so opening an inbox costs O(page) rather than a scan of every
+// conversation.
+template<typename MessageType, typename ParticipantPolicy = GroupPolicy>
+class ConversationStore {
+public:
+    using ConversationType = Conversation<MessageType, ParticipantPolicy>;
+    using ConversationPtr = std::shared_ptr<ConversationType>;
+
+    // One inbox row, resolved to its conversation
+    struct InboxItem {
+        ConversationPtr conversation;
+        DateTime lastActivity;
+        std::size_t unread;
+    };
+
+private:
+    std::unordered_map<int, ConversationPtr> conversations;
+    std::shared_ptr<InboxIndex> inbox = std::make_shared<InboxIndex>();
+
+    std::vector<InboxItem> resolve(const std::vector<InboxEntry>& entries) const {
+        std::vector<InboxItem> items;
+        items.reserve(entries.size());
+        for (const auto& entry : entries) {
+            items.push_back({conversations.at(entry.conversationId), entry.lastActivity, entry.unread});
+        }
+        return items;
+    }
+
+public:
+    ConversationPtr createConversation(const std::vector<int>& participants) {
+        auto conversation = std::make_shared<ConversationType>(participants);
+        addConversation(conversation);
+        return conversation;
+    }
+
+    // Take over an existing conversation, e.g. one reloaded from disk
+    void addConversation(const ConversationPtr& conversation) {
+        if (!conversation) {
+            throw FacebookException("Cannot add a null conversation", "ValidationError");
+        }
+        if (!conversations.emplace(conversation->getId(), conversation).second) {
+            throw FacebookException("Conversation is already in the store", "ValidationError");
+        }
+        conversation->attachInbox(inbox);
+    }
+
+    // Null if there is no such conversation
+    ConversationPtr getConversation(int conversationId) const {
+        auto it = conversations.find(conversationId);
+        return it != conversations.end() ? it->second : nullptr;
+    }
+
+    // The user's most recently active conversations, and the page after a
+    // given row
+    std::vector<InboxItem> getInbox(int userId, std::size_t limit) const {
+        return resolve(inbox->getInbox(userId, limit));
+    }
+    std::vector<InboxItem> getInboxAfter(int userId, const InboxItem& last, std::size_t limit) const {
+        return resolve(inbox->getInboxAfter(userId, {last.conversation->getId(), last.lastActivity, last.unread},
+                                            limit));
+    }
+
+    std::size_t getTotalUnread(int userId) const { return inbox->totalUnread(userId); }
+    std::size_t size() const { return conversations.size(); }
+    const InboxIndex& getInboxIndex() const { return *inbox; }
+};
+
+#endif // CONVERSATION_STORE_H
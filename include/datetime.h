@@ -2,39 +2,95 @@
 #define DATETIME_H
 
 #include <string>
-#include <sstream>
-#include <iomanip>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
 
 class DateTime {
 private:
-    int day;
-    int month;
-    int year;
-    int hour;
-    int minute;
-    int second;  // Added seconds
-    
+    // All fields live in a single 64-bit word, most significant first, so
+    // chronological order is plain unsigned integer order:
+    //   [63..46] year (biased)  [45..42] month   [41..37] day
+    //   [36..32] hour           [31..26] minute  [25..20] second
+    //   [19..0]  microsecond
+    // Values that do not fit their slot are stored as an out-of-range
+    // sentinel so isValid() still rejects them.
+    uint64_t ticks;
+
+    static constexpr int SUBSECOND_BITS = 20;
+    static constexpr int SECOND_SHIFT = SUBSECOND_BITS;
+    static constexpr int MINUTE_SHIFT = SECOND_SHIFT + 6;
+    static constexpr int HOUR_SHIFT = MINUTE_SHIFT + 6;
+    static constexpr int DAY_SHIFT = HOUR_SHIFT + 5;
+    static constexpr int MONTH_SHIFT = DAY_SHIFT + 5;
+    static constexpr int YEAR_SHIFT = MONTH_SHIFT + 4;
+    static constexpr int YEAR_BIAS = 1 << 17;
+
+    static constexpr uint64_t field(int value, int bits, int sentinel) {
+        return static_cast<uint64_t>(value >= 0 && value < (1 << bits) ? value : sentinel);
+    }
+
+    static constexpr uint64_t pack(int day, int month, int year, int hour, int minute, int second,
+                                   int microsecond = 0) {
+        int biasedYear = year + YEAR_BIAS;
+        if (biasedYear < 0) biasedYear = 0;
+        if (biasedYear >= 2 * YEAR_BIAS) biasedYear = 2 * YEAR_BIAS - 1;
+        return (static_cast<uint64_t>(biasedYear) << YEAR_SHIFT) |
+               (field(month, 4, 0) << MONTH_SHIFT) |
+               (field(day, 5, 0) << DAY_SHIFT) |
+               (field(hour, 5, 31) << HOUR_SHIFT) |
+               (field(minute, 6, 63) << MINUTE_SHIFT) |
+               (field(second, 6, 63) << SECOND_SHIFT) |
+               field(microsecond, SUBSECOND_BITS, (1 << SUBSECOND_BITS) - 1);
+    }
+
+    int unpack(int shift, int bits) const {
+        return static_cast<int>((ticks >> shift) & ((uint64_t(1) << bits) - 1));
+    }
+
     bool isLeapYear(int year) const;
     int getDaysInMonth(int month, int year) const;
 
 public:
     // Constructors
-    DateTime(int day, int month, int year)
-        : day(day), month(month), year(year), hour(0), minute(0), second(0) {}
+    constexpr DateTime(int day, int month, int year)
+        : ticks(pack(day, month, year, 0, 0, 0)) {}
         
-    DateTime(int day, int month, int year, int hour, int minute)
-        : day(day), month(month), year(year), hour(hour), minute(minute), second(0) {}
+    constexpr DateTime(int day, int month, int year, int hour, int minute)
+        : ticks(pack(day, month, year, hour, minute, 0)) {}
         
-    DateTime(int day, int month, int year, int hour, int minute, int second)
-        : day(day), month(month), year(year), hour(hour), minute(minute), second(second) {}
+    constexpr DateTime(int day, int month, int year, int hour, int minute, int second)
+        : ticks(pack(day, month, year, hour, minute, second)) {}
+
+    constexpr DateTime(int day, int month, int year, int hour, int minute, int second, int microsecond)
+        : ticks(pack(day, month, year, hour, minute, second, microsecond)) {}
+
+    // Rebuild a DateTime from a value previously returned by getTicks()
+    static constexpr DateTime fromTicks(uint64_t ticks) {
+        DateTime dt(1, 1, 1970);
+        dt.ticks = ticks;
+        return dt;
+    }
     
-    // Getters
+    // Getters (decoded from the packed value on demand)
     int getDay() const;
     int getMonth() const;
     int getYear() const;
     int getHour() const;
     int getMinute() const;
     int getSecond() const;  // Added getter for seconds
+    int getMicrosecond() const;
+    uint64_t getTicks() const { return ticks; }
+
+    // Same calendar second with the sub-second part replaced
+    DateTime withMicrosecond(int microsecond) const {
+        return fromTicks((ticks & ~((uint64_t(1) << SUBSECOND_BITS) - 1)) |
+                         field(microsecond, SUBSECOND_BITS, (1 << SUBSECOND_BITS) - 1));
+    }
+
+    // Seconds since 1970-01-01 00:00:00, treating the fields as UTC
+    int64_t toEpochSeconds() const;
     
     // Validation
     bool isValid() const;
@@ -42,14 +98,30 @@ public:
     // String representation
     std::string toString() const;
     
-    // Comparison operators
-    bool operator<(const DateTime& other) const;
-    bool operator>(const DateTime& other) const;
-    bool operator==(const DateTime& other) const;
+    // Comparison operators (single integer compare on the packed value)
+    bool operator<(const DateTime& other) const { return ticks < other.ticks; }
+    bool operator>(const DateTime& other) const { return ticks > other.ticks; }
+    bool operator<=(const DateTime& other) const { return ticks <= other.ticks; }
+    bool operator>=(const DateTime& other) const { return ticks >= other.ticks; }
+    bool operator==(const DateTime& other) const { return ticks == other.ticks; }
+    bool operator!=(const DateTime& other) const { return ticks != other.ticks; }
     
     // Serialization
     static DateTime deserialize(const std::string& data);
     std::string serialize() const;
+
+    // Allocation-free serialization: "Y-MM-DD hh:mm:ss[.ffffff]" without
+    // locale or streams; the fraction is only written when non-zero.
+    // formatTo() writes at most MAX_SERIALIZED_LENGTH characters (no
+    // terminator) and returns the number written; parse() accepts the same
+    // text, with the time part optional, and returns false on garbage.
+    static constexpr std::size_t MAX_SERIALIZED_LENGTH = 32;
+    std::size_t formatTo(char* buffer) const;
+    static bool parse(std::string_view text, DateTime& result);
+
+    // Parse a whole column of timestamps in one pass; unparsable entries
+    // come back as an invalid DateTime, as with deserialize()
+    static std::vector<DateTime> deserializeBatch(const std::vector<std::string>& data);
 };
 
 #endif // DATETIME_H
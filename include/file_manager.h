@@ -12,18 +12,20 @@
 class FileManager {
 private:
     // Singleton instance
-    static FileManager* instance;
+    inline static FileManager* instance = nullptr;
     
     // File paths
     std::string usersFile;
     std::string postsFile;
     std::string conversationsFile;
+    std::string segmentsDirectory;  // Cold conversation history
     
     // Private constructor for singleton
     FileManager() : 
         usersFile("data/users.json"),
         postsFile("data/posts.json"),
-        conversationsFile("data/conversations.json") {
+        conversationsFile("data/conversations.json"),
+        segmentsDirectory("data/segments") {
         // Create data directory if it doesn't exist
         std::filesystem::create_directories("data");
     }
@@ -45,6 +47,7 @@ public:
     const std::string& getUsersFile() const { return usersFile; }
     const std::string& getPostsFile() const { return postsFile; }
     const std::string& getConversationsFile() const { return conversationsFile; }
+    const std::string& getSegmentsDirectory() const { return segmentsDirectory; }
     
     // Data operations
     template<typename T>
@@ -82,6 +85,19 @@ public:
         }
     }
     
+    // Write raw bytes, with no newline translation
+    void writeBinaryFile(const std::string& filename, const std::string& content) {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw FacebookException("Could not open file for writing: " + filename, "FileError");
+        }
+        
+        file.write(content.data(), static_cast<std::streamsize>(content.size()));
+        if (!file) {
+            throw FacebookException("Error writing to file: " + filename, "FileError");
+        }
+    }
+    
     void appendToFile(const std::string& filename, const std::string& content) {
         std::ofstream file(filename, std::ios::app);
         if (!file.is_open()) {
@@ -124,6 +140,17 @@ public:
         return content;
     }
     
+    std::string readBinaryFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw FacebookException("Could not open file: " + filename, "FileError");
+        }
+        
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+    
     bool fileExists(const std::string& filename) const {
         std::ifstream file(filename);
         return file.good();
@@ -160,7 +187,4 @@ public:
     }
 };
 
-// Initialize static member
-FileManager* FileManager::instance = nullptr;
-
 #endif // FILE_MANAGER_H
@@ -0,0 +1,401 @@
+#ifndef FRIEND_GRAPH_H
+#define FRIEND_GRAPH_H
+
+#include "facebook_exception.h"
+#include "sorted_intersection.h"
+#include "span.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class User;
+
+// Friendships of every user, kept in one place. Users get dense node IDs
+// (reused after removal) and adjacency is stored in compressed sparse row
+// form: one offsets array and one array of friend IDs. Each user's row is
+// split in two sorted runs, regular friends then restricted ones, so either
+// list is a contiguous range and a single lookup tells the relationship.
+// That is about 4 bytes per friendship, and walking a friend list is a
+// sequential scan.
+//
+// An edit copies the user's row out of the CSR into an edited row that
+// takes its place until the next compaction, which happens once edited
+// rows hold more than a fraction of the base.
+//
+// Friendships are mutual: adding one adds both directions. Each side has
+// its own restricted flag, which limits what the other side sees.
+class FriendGraph {
+public:
+    using NodeId = uint32_t;
+    static constexpr NodeId NO_NODE = UINT32_MAX;  // Never issued, since the graph holds fewer users
+
+    // How one user relates to another, from the first user's side
+    enum class Relation {
+        None,
+        Regular,
+        Restricted
+    };
+
+    // Non-owning range of users, read through from a run of friend IDs.
+    // Invalidated, like the run, by the next change to the graph.
+    class UserList {
+    private:
+        Span<NodeId> ids;
+        const FriendGraph* graph;
+
+    public:
+        class const_iterator {
+        private:
+            const NodeId* at;
+            const FriendGraph* graph;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = User*;
+            using difference_type = std::ptrdiff_t;
+            using pointer = User* const*;
+            using reference = User*;
+
+            const_iterator(const NodeId* position, const FriendGraph* owner) : at(position), graph(owner) {}
+            User* operator*() const { return graph->users[*at]; }
+            const_iterator& operator++() {
+                ++at;
+                return *this;
+            }
+            const_iterator operator++(int) {
+                const_iterator previous = *this;
+                ++at;
+                return previous;
+            }
+            bool operator==(const const_iterator& other) const { return at == other.at; }
+            bool operator!=(const const_iterator& other) const { return at != other.at; }
+        };
+
+        UserList(Span<NodeId> friendIds, const FriendGraph* owner) : ids(friendIds), graph(owner) {}
+
+        std::size_t size() const { return ids.size(); }
+        bool empty() const { return ids.empty(); }
+        User* operator[](std::size_t index) const { return graph->users[ids[index]]; }
+        const_iterator begin() const { return const_iterator(ids.begin(), graph); }
+        const_iterator end() const { return const_iterator(ids.end(), graph); }
+
+        // Copy out, for callers that keep the list across changes
+        operator std::vector<User*>() const {
+            std::vector<User*> list;
+            list.reserve(ids.size());
+            for (NodeId id : ids) {
+                list.push_back(graph->users[id]);
+            }
+            return list;
+        }
+    };
+
+    static FriendGraph& getInstance() {
+        static FriendGraph instance;
+        return instance;
+    }
+
+private:
+    // Base adjacency. Row u is targets[offsets[u] .. offsets[u + 1]), with
+    // the restricted run starting at splits[u]; users added since the last
+    // compaction have no base row.
+    std::vector<uint64_t> offsets{0};
+    std::vector<uint64_t> splits;
+    std::vector<NodeId> targets;
+
+    // Rows edited since the last compaction, which override the base row:
+    // ids holds the regular friends then the restricted ones, each sorted.
+    struct EditedRow {
+        std::vector<NodeId> ids;
+        std::size_t regular = 0;
+    };
+    std::unordered_map<NodeId, EditedRow> edited;
+    std::size_t deltaSize = 0;  // Entries in edited rows
+
+    std::vector<User*> users;  // By node ID, null for free IDs
+    std::vector<NodeId> freeIds;
+
+    // Compact once edited rows hold this many entries, or an eighth of the base
+    static constexpr std::size_t MIN_COMPACTION_SIZE = 4096;
+
+    FriendGraph() = default;
+    FriendGraph(const FriendGraph&) = delete;
+    FriendGraph& operator=(const FriendGraph&) = delete;
+
+    // u's current row, wherever it lives
+    struct RowView {
+        const NodeId* ids;
+        std::size_t regular;
+        std::size_t size;
+    };
+    RowView rowOf(NodeId u) const {
+        auto found = edited.find(u);
+        if (found != edited.end()) {
+            return {found->second.ids.data(), found->second.regular, found->second.ids.size()};
+        }
+        if (u + static_cast<std::size_t>(1) >= offsets.size()) {
+            return {nullptr, 0, 0};
+        }
+        return {targets.data() + offsets[u], splits[u] - offsets[u], offsets[u + 1] - offsets[u]};
+    }
+
+    EditedRow& editRow(NodeId u) {
+        auto found = edited.find(u);
+        if (found != edited.end()) {
+            return found->second;
+        }
+        RowView base = rowOf(u);
+        EditedRow& row = edited[u];
+        row.ids.assign(base.ids, base.ids + base.size);
+        row.regular = base.regular;
+        deltaSize += base.size;
+        return row;
+    }
+
+    // Take v out of whichever run of row holds it
+    void removeFrom(EditedRow& row, NodeId v) {
+        auto middle = row.ids.begin() + row.regular;
+        auto it = std::lower_bound(row.ids.begin(), middle, v);
+        if (it != middle && *it == v) {
+            --row.regular;
+        } else {
+            it = std::lower_bound(middle, row.ids.end(), v);
+            if (it == row.ids.end() || *it != v) {
+                return;
+            }
+        }
+        row.ids.erase(it);
+        --deltaSize;
+    }
+
+    void setEdge(NodeId u, NodeId v, bool restricted) {
+        EditedRow& row = editRow(u);
+        removeFrom(row, v);
+        auto middle = row.ids.begin() + row.regular;
+        if (restricted) {
+            row.ids.insert(std::lower_bound(middle, row.ids.end(), v), v);
+        } else {
+            row.ids.insert(std::lower_bound(row.ids.begin(), middle, v), v);
+            ++row.regular;
+        }
+        ++deltaSize;
+    }
+
+    void eraseEdge(NodeId u, NodeId v) {
+        if (getRelation(u, v) != Relation::None) {
+            removeFrom(editRow(u), v);
+        }
+    }
+
+    void maybeCompact() {
+        if (deltaSize >= std::max(MIN_COMPACTION_SIZE, targets.size() / 8)) {
+            compact();
+        }
+    }
+
+    void checkNode(NodeId u) const {
+        if (u >= users.size() || !users[u]) {
+            throw FacebookException("Unknown user in friend graph", "ValidationError");
+        }
+    }
+
+public:
+    // Register a user and return their node ID
+    NodeId addUser(User* user) {
+        if (!user) {
+            throw FacebookException("User cannot be null", "ValidationError");
+        }
+        if (!freeIds.empty()) {
+            NodeId id = freeIds.back();
+            freeIds.pop_back();
+            users[id] = user;
+            return id;
+        }
+        if (users.size() >= static_cast<std::size_t>(UINT32_MAX)) {
+            throw FacebookException("Friend graph is full", "CapacityError");
+        }
+        users.push_back(user);
+        return static_cast<NodeId>(users.size() - 1);
+    }
+
+    // Drop the user and all their friendships; the ID may be reused
+    void removeUser(NodeId u) {
+        checkNode(u);
+        for (NodeId v : getFriends(u)) {
+            eraseEdge(v, u);
+        }
+        EditedRow& row = editRow(u);
+        deltaSize -= row.ids.size();
+        row = EditedRow();
+        users[u] = nullptr;
+        freeIds.push_back(u);
+        maybeCompact();
+    }
+
+    // Point a live node at the object that now holds the user, after a move
+    void relinkUser(NodeId u, User* user) noexcept { users[u] = user; }
+
+    User* getUser(NodeId u) const { return u < users.size() ? users[u] : nullptr; }
+
+    // Make u and v friends. restricted is u's flag for v; v's flag for u
+    // is kept if v already had u as a friend, otherwise regular.
+    void addFriendship(NodeId u, NodeId v, bool restricted = false) {
+        checkNode(u);
+        checkNode(v);
+        if (u == v) {
+            return;
+        }
+        if (getRelation(u, v) != (restricted ? Relation::Restricted : Relation::Regular)) {
+            setEdge(u, v, restricted);
+        }
+        if (getRelation(v, u) == Relation::None) {
+            setEdge(v, u, false);
+        }
+        maybeCompact();
+    }
+
+    void removeFriendship(NodeId u, NodeId v) {
+        if (u >= users.size() || v >= users.size()) {
+            return;
+        }
+        eraseEdge(u, v);
+        eraseEdge(v, u);
+        maybeCompact();
+    }
+
+    // Whether v is u's friend and with which flag, in one lookup
+    Relation getRelation(NodeId u, NodeId v) const {
+        if (u >= users.size()) {
+            return Relation::None;
+        }
+        RowView row = rowOf(u);
+        if (std::binary_search(row.ids, row.ids + row.regular, v)) {
+            return Relation::Regular;
+        }
+        if (std::binary_search(row.ids + row.regular, row.ids + row.size, v)) {
+            return Relation::Restricted;
+        }
+        return Relation::None;
+    }
+
+    bool isFriend(NodeId u, NodeId v) const { return getRelation(u, v) != Relation::None; }
+    bool isRestricted(NodeId u, NodeId v) const { return getRelation(u, v) == Relation::Restricted; }
+
+    // u's regular or restricted friends in ID order, without copying. The
+    // span is invalidated by the next change to the graph.
+    Span<NodeId> getFriendList(NodeId u, bool restricted) const {
+        if (u >= users.size()) {
+            return Span<NodeId>();
+        }
+        RowView row = rowOf(u);
+        return restricted ? Span<NodeId>(row.ids + row.regular, row.size - row.regular)
+                          : Span<NodeId>(row.ids, row.regular);
+    }
+
+    // Call visit(friendId, restricted) for each of u's friends: regular
+    // friends in ID order, then restricted ones in ID order
+    template<typename Visitor>
+    void forEachFriend(NodeId u, Visitor visit) const {
+        for (NodeId v : getFriendList(u, false)) {
+            visit(v, false);
+        }
+        for (NodeId v : getFriendList(u, true)) {
+            visit(v, true);
+        }
+    }
+
+    UserList getFriendUsers(NodeId u, bool restricted) const { return UserList(getFriendList(u, restricted), this); }
+
+    std::vector<NodeId> getFriends(NodeId u) const {
+        std::vector<NodeId> result;
+        forEachFriend(u, [&result](NodeId v, bool) { result.push_back(v); });
+        return result;
+    }
+
+    // Call visit(friendId) for each friend of both u and v. Each pair of
+    // runs is intersected separately, so the order is by ID only within
+    // the pairs. Neither u nor v can be among them, since no one is their
+    // own friend.
+    template<typename Visitor>
+    void forEachMutualFriend(NodeId u, NodeId v, Visitor visit) const {
+        for (bool uRestricted : {false, true}) {
+            Span<NodeId> uFriends = getFriendList(u, uRestricted);
+            for (bool vRestricted : {false, true}) {
+                Span<NodeId> vFriends = getFriendList(v, vRestricted);
+                SortedIntersection::forEach(uFriends.begin(), uFriends.size(), vFriends.begin(), vFriends.size(),
+                                            visit);
+            }
+        }
+    }
+
+    std::vector<NodeId> getMutualFriends(NodeId u, NodeId v) const {
+        std::vector<NodeId> result;
+        forEachMutualFriend(u, v, [&result](NodeId w) { result.push_back(w); });
+        return result;
+    }
+
+    // The number of mutual friends, without building the list
+    std::size_t countMutualFriends(NodeId u, NodeId v) const {
+        std::size_t count = 0;
+        for (bool uRestricted : {false, true}) {
+            Span<NodeId> uFriends = getFriendList(u, uRestricted);
+            for (bool vRestricted : {false, true}) {
+                Span<NodeId> vFriends = getFriendList(v, vRestricted);
+                count += SortedIntersection::count(uFriends.begin(), uFriends.size(), vFriends.begin(), vFriends.size());
+            }
+        }
+        return count;
+    }
+
+    // Fold edited rows into a new CSR. Runs automatically as they grow.
+    void compact() {
+        std::vector<uint64_t> newOffsets;
+        std::vector<uint64_t> newSplits;
+        std::vector<NodeId> newTargets;
+        newOffsets.reserve(users.size() + 1);
+        newSplits.reserve(users.size());
+        newTargets.reserve(edgeCount());
+        newOffsets.push_back(0);
+        for (NodeId u = 0; u < users.size(); ++u) {
+            RowView row = rowOf(u);
+            newSplits.push_back(newTargets.size() + row.regular);
+            newTargets.insert(newTargets.end(), row.ids, row.ids + row.size);
+            newOffsets.push_back(newTargets.size());
+        }
+        offsets = std::move(newOffsets);
+        splits = std::move(newSplits);
+        targets = std::move(newTargets);
+        edited.clear();
+        deltaSize = 0;
+    }
+
+    // Statistics
+    std::size_t userCount() const { return users.size() - freeIds.size(); }
+    std::size_t nodeIdLimit() const { return users.size(); }  // Every node ID is below this
+    std::size_t edgeCount() const {
+        std::size_t count = targets.size();
+        for (const auto& entry : edited) {
+            NodeId u = entry.first;
+            if (u + static_cast<std::size_t>(1) < offsets.size()) {
+                count -= offsets[u + 1] - offsets[u];
+            }
+            count += entry.second.ids.size();
+        }
+        return count;
+    }
+    std::size_t getDeltaSize() const { return deltaSize; }
+    std::size_t memoryUsage() const {
+        std::size_t bytes = offsets.capacity() * sizeof(uint64_t) + splits.capacity() * sizeof(uint64_t) +
+                            targets.capacity() * sizeof(NodeId) + users.capacity() * sizeof(User*);
+        for (const auto& entry : edited) {
+            bytes += sizeof(entry) + entry.second.ids.capacity() * sizeof(NodeId);
+        }
+        return bytes;
+    }
+};
+
+#endif // FRIEND_GRAPH_H
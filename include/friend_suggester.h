@@ -0,0 +1,159 @@
+#ifndef FRIEND_SUGGESTER_H
+#define FRIEND_SUGGESTER_H
+
+#include "friend_graph.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// "People you may know": ranks the friends of a user's friends by how many
+// friends they share with the user, leaving out the user and their current
+// friends. Each thread counts into its own sparse accumulator (a counter
+// per node ID plus the list of IDs it touched, so resetting costs only what
+// was touched) and keeps the best K in a min-heap.
+//
+// suggestFor() serves one user on demand. suggestAll() is the batch run: it
+// splits users across threads, which take chunks of IDs as they finish so
+// that a few users with huge friend lists do not stall one thread. Neither
+// may run while the graph is being changed.
+class FriendSuggester {
+public:
+    using NodeId = FriendGraph::NodeId;
+
+    struct Suggestion {
+        NodeId user;
+        uint32_t mutualFriends;
+
+        bool operator==(const Suggestion& other) const {
+            return user == other.user && mutualFriends == other.mutualFriends;
+        }
+    };
+
+private:
+    static constexpr uint32_t EXCLUDED = UINT32_MAX;
+    static constexpr std::size_t CHUNK_SIZE = 64;  // Users per batch work item
+
+    struct Accumulator {
+        std::vector<uint32_t> counts;  // By node ID, zero when untouched
+        std::vector<NodeId> touched;
+        std::vector<Suggestion> heap;
+    };
+
+    const FriendGraph& graph;
+
+    // Higher count first, then lower ID, so results do not depend on the
+    // order of friend lists
+    static bool ranksBefore(const Suggestion& a, const Suggestion& b) {
+        return a.mutualFriends != b.mutualFriends ? a.mutualFriends > b.mutualFriends : a.user < b.user;
+    }
+
+    void suggestInto(NodeId u, std::size_t limit, Accumulator& acc, std::vector<Suggestion>& result) const {
+        result.clear();
+        if (limit == 0 || !graph.getUser(u)) {
+            return;
+        }
+        if (acc.counts.size() < graph.nodeIdLimit()) {
+            acc.counts.resize(graph.nodeIdLimit(), 0);
+        }
+
+        acc.counts[u] = EXCLUDED;
+        acc.touched.push_back(u);
+        graph.forEachFriend(u, [&acc](NodeId f, bool) {
+            acc.counts[f] = EXCLUDED;
+            acc.touched.push_back(f);
+        });
+        graph.forEachFriend(u, [&](NodeId f, bool) {
+            graph.forEachFriend(f, [&acc](NodeId w, bool) {
+                uint32_t& count = acc.counts[w];
+                if (count == EXCLUDED) {
+                    return;
+                }
+                if (count++ == 0) {
+                    acc.touched.push_back(w);
+                }
+            });
+        });
+
+        // Min-heap of the best limit so far: its front is the weakest kept
+        acc.heap.clear();
+        for (NodeId w : acc.touched) {
+            uint32_t count = acc.counts[w];
+            acc.counts[w] = 0;
+            if (count == EXCLUDED) {
+                continue;
+            }
+            Suggestion candidate{w, count};
+            if (acc.heap.size() < limit) {
+                acc.heap.push_back(candidate);
+                std::push_heap(acc.heap.begin(), acc.heap.end(), ranksBefore);
+            } else if (ranksBefore(candidate, acc.heap.front())) {
+                std::pop_heap(acc.heap.begin(), acc.heap.end(), ranksBefore);
+                acc.heap.back() = candidate;
+                std::push_heap(acc.heap.begin(), acc.heap.end(), ranksBefore);
+            }
+        }
+        acc.touched.clear();
+        std::sort_heap(acc.heap.begin(), acc.heap.end(), ranksBefore);
+        result.assign(acc.heap.begin(), acc.heap.end());
+    }
+
+    // Accumulator for on-demand queries, reused across calls on the same thread
+    static Accumulator& localAccumulator() {
+        thread_local Accumulator accumulator;
+        return accumulator;
+    }
+
+public:
+    explicit FriendSuggester(const FriendGraph& friendGraph = FriendGraph::getInstance()) : graph(friendGraph) {}
+
+    // Up to limit suggestions for u, best first. Empty for unknown users.
+    std::vector<Suggestion> suggestFor(NodeId u, std::size_t limit) const {
+        std::vector<Suggestion> result;
+        suggestInto(u, limit, localAccumulator(), result);
+        return result;
+    }
+
+    // Suggestions for every user, indexed by node ID, computed on threadCount
+    // threads (0 means one per hardware thread)
+    std::vector<std::vector<Suggestion>> suggestAll(std::size_t limit, unsigned threadCount = 0) const {
+        std::size_t nodeCount = graph.nodeIdLimit();
+        std::vector<std::vector<Suggestion>> results(nodeCount);
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threadCount = static_cast<unsigned>(
+            std::min<std::size_t>(threadCount, (nodeCount + CHUNK_SIZE - 1) / CHUNK_SIZE));
+
+        std::atomic<std::size_t> nextChunk{0};
+        auto work = [&]() {
+            Accumulator acc;
+            for (;;) {
+                std::size_t begin = nextChunk.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+                if (begin >= nodeCount) {
+                    return;
+                }
+                std::size_t end = std::min(begin + CHUNK_SIZE, nodeCount);
+                for (std::size_t u = begin; u < end; ++u) {
+                    suggestInto(static_cast<NodeId>(u), limit, acc, results[u]);
+                }
+            }
+        };
+        if (threadCount <= 1) {
+            work();
+            return results;
+        }
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            threads.emplace_back(work);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return results;
+    }
+};
+
+#endif // FRIEND_SUGGESTER_H
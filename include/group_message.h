@@ -0,0 +1,134 @@
+#ifndef GROUP_MESSAGE_H
+#define GROUP_MESSAGE_H
+
+#include "datetime.h"
+#include "clock.h"
+#include "facebook_exception.h"
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A message addressed to every member of a group conversation. The content
+// is stored once; who it was delivered to and who has read it are two
+// bitmaps indexed by participant slot, a small number the Conversation
+// gives each member for life. A message to a 500-member group costs about
+// 125 bytes of state instead of 499 copies of Message.
+class GroupMessage {
+private:
+    int senderId;
+    std::string content;
+    DateTime timestamp;
+    uint64_t sequence;  // Position within its conversation, 0 until added
+
+    // Delivered bitmap in the first words entries, read bitmap in the rest
+    std::vector<uint64_t> bits;
+    std::size_t words;
+
+    void validate() const {
+        if (content.empty()) {
+            throw FacebookException("Message content cannot be empty", "ValidationError");
+        }
+        if (senderId <= 0) {
+            throw FacebookException("Invalid user ID", "ValidationError");
+        }
+    }
+
+    bool test(std::size_t base, std::size_t slot) const {
+        return slot / 64 < words && (bits[base + slot / 64] >> (slot % 64) & 1);
+    }
+
+    std::size_t popcount(std::size_t base) const {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < words; ++i) {
+            count += std::bitset<64>(bits[base + i]).count();
+        }
+        return count;
+    }
+
+public:
+    GroupMessage(int sender, const std::string& msg)
+        : senderId(sender), content(msg), timestamp(Clock::getInstance().now()), sequence(0), words(0) {
+        validate();
+    }
+
+    // Rebuild a stored message with its original timestamp
+    GroupMessage(int sender, const std::string& msg, const DateTime& sentAt)
+        : senderId(sender), content(msg), timestamp(sentAt), sequence(0), words(0) {
+        validate();
+    }
+
+    // Getters
+    int getSenderId() const { return senderId; }
+    const std::string& getContent() const { return content; }
+    const DateTime& getTimestamp() const { return timestamp; }
+    uint64_t getSequence() const { return sequence; }
+
+    // Assigned by Conversation::addMessage, like Message::setSequence()
+    void setSequence(uint64_t value) { sequence = value; }
+
+    // Set by Conversation::addMessage: deliver to every slot in the
+    // recipients bitmap except the sender's. Clears any earlier state.
+    void deliver(const std::vector<uint64_t>& recipients, std::size_t senderSlot) {
+        words = recipients.size();
+        bits.assign(2 * words, 0);
+        std::copy(recipients.begin(), recipients.end(), bits.begin());
+        if (senderSlot / 64 < words) {
+            bits[senderSlot / 64] &= ~(uint64_t(1) << (senderSlot % 64));
+        }
+    }
+
+    bool isDeliveredTo(std::size_t slot) const { return test(0, slot); }
+    bool isReadBy(std::size_t slot) const { return test(words, slot); }
+
+    // Returns false if the slot was not delivered to or had already read it.
+    // Read state is per message; prefer Conversation::markAsRead(), which
+    // also keeps the unread counters.
+    bool markReadBy(std::size_t slot) {
+        if (!isDeliveredTo(slot) || isReadBy(slot)) {
+            return false;
+        }
+        bits[words + slot / 64] |= uint64_t(1) << (slot % 64);
+        return true;
+    }
+
+    std::size_t recipientCount() const { return popcount(0); }
+    std::size_t readCount() const { return popcount(words); }
+    bool isReadByAll() const { return readCount() == recipientCount(); }
+
+    // String representation
+    std::string toString() const {
+        std::stringstream ss;
+        ss << "From: " << senderId << "\n"
+           << "To: " << recipientCount() << " participants\n"
+           << "Time: " << timestamp.toString() << "\n"
+           << "Read by: " << readCount() << "\n"
+           << "Content: " << content;
+        return ss.str();
+    }
+
+    // Comparison operators (based on timestamp, then conversation sequence)
+    bool operator<(const GroupMessage& other) const {
+        return timestamp < other.timestamp ||
+               (timestamp == other.timestamp && sequence < other.sequence);
+    }
+
+    bool operator>(const GroupMessage& other) const {
+        return other < *this;
+    }
+};
+
+// True for message types addressed to the whole conversation, tracking read
+// state per participant slot (GroupMessage) rather than a single receiver
+template<typename MessageType, typename = void>
+struct IsGroupMessage : std::false_type {};
+template<typename MessageType>
+struct IsGroupMessage<MessageType, std::void_t<decltype(std::declval<MessageType&>().markReadBy(std::size_t()))>>
+    : std::true_type {};
+
+#endif // GROUP_MESSAGE_H
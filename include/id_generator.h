@@ -0,0 +1,74 @@
+#ifndef ID_GENERATOR_H
+#define ID_GENERATOR_H
+
+#include "facebook_exception.h"
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+// Hands out unique positive IDs for one kind of entity, identified by Tag.
+// Each thread reserves a block of BLOCK_SIZE IDs from the shared counter and
+// then serves IDs from that block without touching shared state, so
+// constructing entities on many cores does not bounce a cache line.
+// IDs are increasing within a thread. Across threads they are unique but
+// not ordered.
+//
+// After reloading persisted entities, call observe() with the largest ID
+// that was loaded. Every ID handed out afterwards is larger, on all threads.
+template<typename Tag>
+class IdGenerator {
+public:
+    static constexpr int BLOCK_SIZE = 256;
+
+    static int next() {
+        Block& block = localBlock();
+        uint64_t currentEpoch = epoch.load(std::memory_order_acquire);
+        if (block.next == block.end || block.epoch != currentEpoch) {
+            refill(block, currentEpoch);
+        }
+        return block.next++;
+    }
+
+    // Guarantees that every ID handed out from now on is greater than id
+    static void observe(int id) {
+        int current = reserved.load(std::memory_order_relaxed);
+        while (current < id &&
+               !reserved.compare_exchange_weak(current, id, std::memory_order_relaxed)) {
+        }
+        // Blocks reserved before this call may hold IDs at or below id
+        epoch.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    struct Block {
+        int next = 0;
+        int end = 0;
+        uint64_t epoch = 0;
+    };
+
+    // Last ID reserved by any thread, and a counter bumped by observe() so
+    // that threads drop blocks reserved before the reseed
+    alignas(64) inline static std::atomic<int> reserved{0};
+    alignas(64) inline static std::atomic<uint64_t> epoch{0};
+
+    static Block& localBlock() {
+        thread_local Block block;
+        return block;
+    }
+
+    static void refill(Block& block, uint64_t currentEpoch) {
+        int first = reserved.fetch_add(BLOCK_SIZE, std::memory_order_relaxed);
+        if (first < 0 || first >= INT_MAX - BLOCK_SIZE) {
+            throw FacebookException("ID space exhausted", "CapacityError");
+        }
+        block.next = first + 1;
+        block.end = first + 1 + BLOCK_SIZE;
+        block.epoch = currentEpoch;
+    }
+};
+
+// Shared by Conversation and ConcurrentConversation so that conversation
+// IDs are unique across both kinds
+struct ConversationIdTag {};
+
+#endif // ID_GENERATOR_H
@@ -0,0 +1,149 @@
+#ifndef INBOX_INDEX_H
+#define INBOX_INDEX_H
+
+#include "datetime.h"
+#include <cstddef>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+// One conversation as it appears in a user's inbox
+struct InboxEntry {
+    int conversationId;
+    DateTime lastActivity;
+    std::size_t unread;
+};
+
+// Per-user list of conversations, most recently active first, with unread
+// counts per conversation and in total. Conversations report to it as they
+// change (Conversation::attachInbox()). Moving a conversation up one
+// user's inbox is O(log n) in the number of conversations they are in, so
+// a new newest message costs that once per member; unread counts are O(1)
+// to update and only change for the message's receivers. A page of the
+// inbox costs O(log n + page) however many conversations there are.
+class InboxIndex {
+private:
+    struct Key {
+        DateTime lastActivity;
+        int conversationId;
+    };
+
+    // Newest activity first; ties by conversation ID so keys are unique
+    struct NewestFirst {
+        bool operator()(const Key& a, const Key& b) const {
+            return b.lastActivity < a.lastActivity ||
+                   (a.lastActivity == b.lastActivity && a.conversationId < b.conversationId);
+        }
+    };
+
+    struct Entry {
+        DateTime lastActivity;
+        std::size_t unread;
+    };
+
+    struct UserInbox {
+        std::set<Key, NewestFirst> order;
+        std::unordered_map<int, Entry> entries;
+        std::size_t totalUnread = 0;
+    };
+
+    std::unordered_map<int, UserInbox> users;
+
+    // Activity time of a conversation that has no messages yet
+    static constexpr DateTime NO_ACTIVITY = DateTime(0, 0, 0);
+
+    static std::vector<InboxEntry> page(const UserInbox& inbox, std::set<Key, NewestFirst>::const_iterator from,
+                                        std::size_t limit) {
+        std::vector<InboxEntry> result;
+        for (auto it = from; it != inbox.order.end() && result.size() < limit; ++it) {
+            result.push_back({it->conversationId, it->lastActivity, inbox.entries.at(it->conversationId).unread});
+        }
+        return result;
+    }
+
+public:
+    // Add the conversation to the user's inbox, or move it to the given
+    // activity time if that is newer
+    void touch(int userId, int conversationId, const DateTime& lastActivity) {
+        UserInbox& inbox = users[userId];
+        auto [it, inserted] = inbox.entries.try_emplace(conversationId, Entry{lastActivity, 0});
+        if (inserted) {
+            inbox.order.insert({lastActivity, conversationId});
+            return;
+        }
+        if (!(it->second.lastActivity < lastActivity)) {
+            return;
+        }
+        inbox.order.erase({it->second.lastActivity, conversationId});
+        inbox.order.insert({lastActivity, conversationId});
+        it->second.lastActivity = lastActivity;
+    }
+
+    // Add the conversation with no activity yet; no-op if already listed
+    void add(int userId, int conversationId) {
+        touch(userId, conversationId, NO_ACTIVITY);
+    }
+
+    void setUnread(int userId, int conversationId, std::size_t unread) {
+        auto user = users.find(userId);
+        if (user == users.end()) {
+            return;
+        }
+        auto it = user->second.entries.find(conversationId);
+        if (it == user->second.entries.end()) {
+            return;
+        }
+        user->second.totalUnread += unread;
+        user->second.totalUnread -= it->second.unread;
+        it->second.unread = unread;
+    }
+
+    void remove(int userId, int conversationId) {
+        auto user = users.find(userId);
+        if (user == users.end()) {
+            return;
+        }
+        UserInbox& inbox = user->second;
+        auto it = inbox.entries.find(conversationId);
+        if (it == inbox.entries.end()) {
+            return;
+        }
+        inbox.totalUnread -= it->second.unread;
+        inbox.order.erase({it->second.lastActivity, conversationId});
+        inbox.entries.erase(it);
+        if (inbox.entries.empty()) {
+            users.erase(user);
+        }
+    }
+
+    // The user's most recently active conversations
+    std::vector<InboxEntry> getInbox(int userId, std::size_t limit) const {
+        auto user = users.find(userId);
+        if (user == users.end()) {
+            return {};
+        }
+        return page(user->second, user->second.order.begin(), limit);
+    }
+
+    // The next page after an entry returned earlier. Conversations that
+    // became active since then have moved to the top and are not repeated.
+    std::vector<InboxEntry> getInboxAfter(int userId, const InboxEntry& last, std::size_t limit) const {
+        auto user = users.find(userId);
+        if (user == users.end()) {
+            return {};
+        }
+        return page(user->second, user->second.order.upper_bound({last.lastActivity, last.conversationId}), limit);
+    }
+
+    std::size_t totalUnread(int userId) const {
+        auto user = users.find(userId);
+        return user != users.end() ? user->second.totalUnread : 0;
+    }
+
+    std::size_t conversationCount(int userId) const {
+        auto user = users.find(userId);
+        return user != users.end() ? user->second.entries.size() : 0;
+    }
+};
+
+#endif // INBOX_INDEX_H
@@ -2,11 +2,12 @@
 #define MESSAGE_H
 
 #include "datetime.h"
+#include "clock.h"
 #include "facebook_exception.h"
 #include <string>
 #include <sstream>
+#include <cstdint>
 #include <chrono>
-#include <ctime>
 #include <thread>
 
 class Message {
@@ -15,28 +16,9 @@ private:
     int receiverId;
     std::string content;
     DateTime timestamp;
+    uint64_t sequence;  // Position within its conversation, 0 until added
     bool read;
 
-    DateTime getCurrentTime() const {
-        auto now = std::chrono::system_clock::now();
-        std::time_t time = std::chrono::system_clock::to_time_t(now);
-        std::tm* ltm = std::localtime(&time);
-        
-        // Get milliseconds
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()
-        ).count() % 1000;
-        
-        return DateTime(
-            ltm->tm_mday,
-            1 + ltm->tm_mon,
-            1900 + ltm->tm_year,
-            ltm->tm_hour,
-            ltm->tm_min,
-            ltm->tm_sec
-        );
-    }
-
     void validate() const {
         if (content.empty()) {
             throw FacebookException("Message content cannot be empty", "ValidationError");
@@ -49,7 +31,14 @@ private:
 public:
     Message(int sender, int receiver, const std::string& msg)
         : senderId(sender), receiverId(receiver), content(msg), 
-          timestamp(getCurrentTime()), read(false) {
+          timestamp(Clock::getInstance().now()), sequence(0), read(false) {
+        validate();
+    }
+
+    // Rebuild a stored message with its original timestamp
+    Message(int sender, int receiver, const std::string& msg, const DateTime& sentAt)
+        : senderId(sender), receiverId(receiver), content(msg),
+          timestamp(sentAt), sequence(0), read(false) {
         validate();
     }
 
@@ -58,9 +47,15 @@ public:
     int getReceiverId() const { return receiverId; }
     const std::string& getContent() const { return content; }
     const DateTime& getTimestamp() const { return timestamp; }
+    uint64_t getSequence() const { return sequence; }
     bool isRead() const { return read; }
 
-    // Mark message as read
+    // Assigned by Conversation::addMessage; breaks ties between messages
+    // stamped within the same microsecond
+    void setSequence(uint64_t value) { sequence = value; }
+
+    // Mark message as read. Once the message is in a Conversation, read it
+    // through Conversation::markAsRead(), which keeps the read state.
     void markAsRead() { read = true; }
 
     // String representation
@@ -74,17 +69,20 @@ public:
         return ss.str();
     }
 
-    // Comparison operators (based on timestamp)
+    // Comparison operators (based on timestamp, then conversation sequence)
     bool operator<(const Message& other) const {
-        return timestamp < other.timestamp;
+        return timestamp < other.timestamp ||
+               (timestamp == other.timestamp && sequence < other.sequence);
     }
 
     bool operator>(const Message& other) const {
-        return timestamp > other.timestamp;
+        return other < *this;
     }
 
+    // Consistent with operator<: equal messages never order before each other
     bool operator==(const Message& other) const {
         return timestamp == other.timestamp &&
+               sequence == other.sequence &&
                senderId == other.senderId &&
                receiverId == other.receiverId &&
                content == other.content;
@@ -0,0 +1,322 @@
+#ifndef MESSAGE_INDEX_H
+#define MESSAGE_INDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// True when MessageType has a getContent() the index can tokenize
+template<typename MessageType, typename = void>
+struct HasContent : std::false_type {};
+template<typename MessageType>
+struct HasContent<MessageType, std::void_t<decltype(std::declval<const MessageType&>().getContent())>>
+    : std::true_type {};
+
+// Inverted full-text index over messages from any number of conversations.
+// Messages are added incrementally (Conversation::attachIndex() keeps one up
+// to date) and numbered in the order they were added. Postings are kept per
+// conversation, so a search scoped to one user's conversations only reads
+// their lists however large the rest of the corpus is. Each postings list
+// stores, per message, the gap from the previous message number, the number
+// of occurrences and the gaps between positions, all as varints.
+//
+// Tokens are maximal runs of ASCII letters and digits, lower-cased; bytes
+// outside ASCII are kept inside tokens so UTF-8 words stay whole.
+template<typename MessageType>
+class MessageIndex {
+public:
+    using MessagePtr = std::shared_ptr<MessageType>;
+
+private:
+    struct Postings {
+        std::vector<uint8_t> bytes;
+        uint32_t lastDocument = 0;
+    };
+
+    // Decodes one postings list in document order
+    class Cursor {
+    private:
+        const std::vector<uint8_t>* bytes;
+        std::size_t offset = 0;
+        uint32_t document = 0;
+        std::vector<uint32_t> positions;
+
+    public:
+        explicit Cursor(const Postings& postings) : bytes(&postings.bytes) {}
+
+        // Move to the next document, false once the list is exhausted
+        bool next() {
+            if (offset == bytes->size()) {
+                return false;
+            }
+            document += readVarint(*bytes, offset);
+            positions.resize(readVarint(*bytes, offset));
+            uint32_t position = 0;
+            for (auto& value : positions) {
+                position += readVarint(*bytes, offset);
+                value = position;
+            }
+            return true;
+        }
+
+        // Move to the first document at or after target
+        bool seek(uint32_t target) {
+            while (document < target) {
+                if (!next()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        uint32_t getDocument() const { return document; }
+        bool hasPosition(uint32_t position) const {
+            return std::binary_search(positions.begin(), positions.end(), position);
+        }
+        const std::vector<uint32_t>& getPositions() const { return positions; }
+    };
+
+    using Terms = std::unordered_map<std::string, Postings>;
+
+    std::vector<MessagePtr> documents;  // Indexed by message number
+    std::unordered_map<int, Terms> conversations;
+    std::size_t postingBytes = 0;
+
+    // Most lists cover a handful of messages; start them big enough for that
+    static constexpr std::size_t INITIAL_POSTINGS_BYTES = 16;
+
+    // Buffers reused by add() so indexing a message allocates only for new terms
+    struct Scratch {
+        std::string folded;
+        std::vector<std::string_view> tokens;
+        std::vector<uint32_t> order;
+        std::vector<uint8_t> entry;
+    } scratch;
+
+    static void writeVarint(std::vector<uint8_t>& out, uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint32_t readVarint(const std::vector<uint8_t>& in, std::size_t& offset) {
+        uint32_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t byte = in[offset++];
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+    }
+
+    static bool isTokenByte(unsigned char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+    }
+
+    // Messages containing every query token, or the tokens as a phrase, in
+    // the given conversations (all of them when conversationIds is null)
+    std::vector<MessagePtr> match(std::string_view query, const std::vector<int>* conversationIds,
+                                  bool phrase) const {
+        std::vector<MessagePtr> results;
+        std::vector<std::string> tokens = tokenize(query);
+        if (tokens.empty()) {
+            return results;
+        }
+
+        std::vector<uint32_t> matches;
+        if (conversationIds) {
+            for (int conversationId : *conversationIds) {
+                auto it = conversations.find(conversationId);
+                if (it != conversations.end()) {
+                    matchConversation(it->second, tokens, phrase, matches);
+                }
+            }
+        } else {
+            for (const auto& entry : conversations) {
+                matchConversation(entry.second, tokens, phrase, matches);
+            }
+        }
+
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+        results.reserve(matches.size());
+        for (uint32_t document : matches) {
+            results.push_back(documents[document]);
+        }
+        return results;
+    }
+
+    static void matchConversation(const Terms& terms, const std::vector<std::string>& tokens, bool phrase,
+                                  std::vector<uint32_t>& matches) {
+        std::vector<Cursor> cursors;
+        cursors.reserve(tokens.size());
+        for (const auto& token : tokens) {
+            auto it = terms.find(token);
+            if (it == terms.end()) {
+                return;
+            }
+            cursors.emplace_back(it->second);
+        }
+        for (auto& cursor : cursors) {
+            if (!cursor.next()) {
+                return;
+            }
+        }
+
+        // Leapfrog every cursor to the largest current document until they agree
+        while (true) {
+            uint32_t target = 0;
+            for (const auto& cursor : cursors) {
+                target = std::max(target, cursor.getDocument());
+            }
+            bool aligned = true;
+            for (auto& cursor : cursors) {
+                if (!cursor.seek(target)) {
+                    return;
+                }
+                aligned = aligned && cursor.getDocument() == target;
+            }
+            if (!aligned) {
+                continue;
+            }
+
+            if (!phrase || isPhrase(cursors)) {
+                matches.push_back(target);
+            }
+            if (!cursors[0].next()) {
+                return;
+            }
+        }
+    }
+
+    // Cursors all on one document: does token i appear at start + i?
+    static bool isPhrase(const std::vector<Cursor>& cursors) {
+        for (uint32_t start : cursors[0].getPositions()) {
+            bool found = true;
+            for (std::size_t i = 1; i < cursors.size() && found; ++i) {
+                found = cursors[i].hasPosition(start + static_cast<uint32_t>(i));
+            }
+            if (found) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Splits text into tokens viewing folded, a lower-cased copy of text
+    static void split(std::string_view text, std::string& folded, std::vector<std::string_view>& tokens) {
+        folded.assign(text);
+        for (char& c : folded) {
+            if (c >= 'A' && c <= 'Z') {
+                c = static_cast<char>(c - 'A' + 'a');
+            }
+        }
+        tokens.clear();
+        std::size_t i = 0;
+        while (i < folded.size()) {
+            while (i < folded.size() && !isTokenByte(static_cast<unsigned char>(folded[i]))) {
+                ++i;
+            }
+            std::size_t start = i;
+            while (i < folded.size() && isTokenByte(static_cast<unsigned char>(folded[i]))) {
+                ++i;
+            }
+            if (i > start) {
+                tokens.push_back(std::string_view(folded).substr(start, i - start));
+            }
+        }
+    }
+
+public:
+    static std::vector<std::string> tokenize(std::string_view text) {
+        std::string folded;
+        std::vector<std::string_view> views;
+        split(text, folded, views);
+        return std::vector<std::string>(views.begin(), views.end());
+    }
+
+    void add(int conversationId, const MessagePtr& message) {
+        static_assert(HasContent<MessageType>::value, "MessageIndex needs MessageType::getContent()");
+        if (!message) {
+            return;
+        }
+        uint32_t document = static_cast<uint32_t>(documents.size());
+        documents.push_back(message);
+
+        // Sort positions by term, then position, to give every list one
+        // entry per message
+        std::vector<std::string_view>& tokens = scratch.tokens;
+        std::vector<uint32_t>& order = scratch.order;
+        std::vector<uint8_t>& entry = scratch.entry;
+        split(message->getContent(), scratch.folded, tokens);
+        order.resize(tokens.size());
+        for (uint32_t position = 0; position < order.size(); ++position) {
+            order[position] = position;
+        }
+        std::sort(order.begin(), order.end(), [&tokens](uint32_t a, uint32_t b) {
+            return tokens[a] < tokens[b] || (tokens[a] == tokens[b] && a < b);
+        });
+
+        Terms& terms = conversations[conversationId];
+        for (std::size_t first = 0, last = 0; first < order.size(); first = last) {
+            std::string_view token = tokens[order[first]];
+            for (last = first + 1; last < order.size() && tokens[order[last]] == token; ++last) {
+            }
+            std::string key(token);
+            auto it = terms.find(key);
+            if (it == terms.end()) {
+                it = terms.emplace(std::move(key), Postings()).first;
+                it->second.bytes.reserve(INITIAL_POSTINGS_BYTES);
+            }
+            Postings& postings = it->second;
+
+            // Encode the entry first so the list grows once per message
+            entry.clear();
+            writeVarint(entry, document - postings.lastDocument);
+            writeVarint(entry, static_cast<uint32_t>(last - first));
+            uint32_t previous = 0;
+            for (std::size_t i = first; i < last; ++i) {
+                writeVarint(entry, order[i] - previous);
+                previous = order[i];
+            }
+            postings.bytes.insert(postings.bytes.end(), entry.begin(), entry.end());
+            postings.lastDocument = document;
+            postingBytes += entry.size();
+        }
+    }
+
+    // Messages containing every word of the query, in the order they were
+    // indexed. conversationIds, when given, limits the search to those
+    // conversations (e.g. the ones a user belongs to).
+    std::vector<MessagePtr> search(std::string_view query) const {
+        return match(query, nullptr, false);
+    }
+    std::vector<MessagePtr> search(std::string_view query, const std::vector<int>& conversationIds) const {
+        return match(query, &conversationIds, false);
+    }
+
+    // Messages containing the query's words consecutively and in order
+    std::vector<MessagePtr> searchPhrase(std::string_view query) const {
+        return match(query, nullptr, true);
+    }
+    std::vector<MessagePtr> searchPhrase(std::string_view query, const std::vector<int>& conversationIds) const {
+        return match(query, &conversationIds, true);
+    }
+
+    // Statistics
+    std::size_t size() const { return documents.size(); }
+    std::size_t conversationCount() const { return conversations.size(); }
+    std::size_t postingsSize() const { return postingBytes; }
+};
+
+#endif // MESSAGE_INDEX_H
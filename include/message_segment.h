@@ -0,0 +1,248 @@
+#ifndef MESSAGE_SEGMENT_H
+#define MESSAGE_SEGMENT_H
+
+#include "datetime.h"
+#include "facebook_exception.h"
+#include "file_manager.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// A message as stored in a segment. content points into the mapping and
+// is valid while the segment stays mapped.
+struct StoredMessage {
+    int senderId;
+    int receiverId;
+    DateTime timestamp;
+    uint64_t sequence;
+    bool read;
+    std::string_view content;
+};
+
+// Immutable on-disk run of messages, written once through FileManager and
+// memory-mapped on first read. Used by Conversation as its cold tier, so a
+// segment is a cache file rather than persistence: it owns its file and
+// deletes it when destroyed.
+//
+// Layout (native byte order): "FBCS", version, message count, reserved
+// (4 x uint32), an offset table (uint64 per message), then per message:
+// sender and receiver (int32), timestamp ticks and sequence (uint64), read
+// flag (uint8), content length (uint32) and the content bytes.
+class MessageSegment {
+private:
+    static constexpr char MAGIC[4] = {'F', 'B', 'C', 'S'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 16;
+    static constexpr std::size_t FIXED_RECORD_SIZE = 4 + 4 + 8 + 8 + 1 + 4;
+
+    std::string path;
+    std::size_t count;
+    DateTime oldest;
+    DateTime newest;
+
+    // Mapping, created on first access
+    mutable const char* data = nullptr;
+    mutable std::size_t length = 0;
+#ifdef _WIN32
+    mutable std::string buffer;
+#endif
+
+    MessageSegment(const std::string& file, std::size_t messageCount, const DateTime& from, const DateTime& to)
+        : path(file), count(messageCount), oldest(from), newest(to) {}
+
+    template<typename T>
+    static void put(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    T get(std::size_t offset) const {
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        return value;
+    }
+
+    void corrupt() const {
+        throw FacebookException("Corrupt message segment: " + path, "FileError");
+    }
+
+    void map() const {
+        if (data) {
+            return;
+        }
+#ifdef _WIN32
+        buffer = FileManager::getInstance().readBinaryFile(path);
+        data = buffer.data();
+        length = buffer.size();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw FacebookException("Could not open message segment: " + path, "FileError");
+        }
+        struct stat info {};
+        void* mapping = MAP_FAILED;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            throw FacebookException("Could not map message segment: " + path, "FileError");
+        }
+        data = static_cast<const char*>(mapping);
+        length = static_cast<std::size_t>(info.st_size);
+#endif
+        if (length < HEADER_SIZE + count * sizeof(uint64_t) || std::memcmp(data, MAGIC, 4) != 0 ||
+            get<uint32_t>(4) != VERSION || get<uint32_t>(8) != count) {
+            unmap();
+            corrupt();
+        }
+    }
+
+    // Write a new file, failing rather than truncating one that exists:
+    // another process sharing the directory may have it mapped
+    static void create(const std::string& path, const std::string& bytes) {
+#ifdef _WIN32
+        std::error_code ignored;
+        if (std::filesystem::exists(path, ignored)) {
+            throw FacebookException("Message segment already exists: " + path, "FileError");
+        }
+        FileManager::getInstance().writeBinaryFile(path, bytes);
+#else
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (fd < 0) {
+            throw FacebookException("Could not create message segment: " + path, "FileError");
+        }
+        std::size_t written = 0;
+        while (written < bytes.size()) {
+            ssize_t step = ::write(fd, bytes.data() + written, bytes.size() - written);
+            if (step < 0 && errno == EINTR) {
+                continue;
+            }
+            if (step <= 0) {
+                break;
+            }
+            written += static_cast<std::size_t>(step);
+        }
+        ::close(fd);
+        if (written < bytes.size()) {
+            ::unlink(path.c_str());
+            throw FacebookException("Error writing message segment: " + path, "FileError");
+        }
+#endif
+    }
+
+public:
+    MessageSegment(const MessageSegment&) = delete;
+    MessageSegment& operator=(const MessageSegment&) = delete;
+
+    ~MessageSegment() {
+        unmap();
+        std::error_code ignored;
+        std::filesystem::remove(path, ignored);
+    }
+
+    // Random tag for this process, for segment names that cannot collide
+    // with another process writing to the same directory
+    static const std::string& processTag() {
+        static const std::string tag = [] {
+            std::random_device source;
+            uint64_t value = (static_cast<uint64_t>(source()) << 32) ^ source();
+            char text[17];
+            std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+            return std::string(text);
+        }();
+        return tag;
+    }
+
+    // Write messages, already in timeline order, to a new segment at path.
+    // Throws FileError if a file already exists there.
+    template<typename MessageType>
+    static std::shared_ptr<MessageSegment> write(const std::string& path,
+                                                 const std::vector<std::shared_ptr<MessageType>>& messages) {
+        if (messages.empty()) {
+            throw FacebookException("Cannot write an empty message segment", "ValidationError");
+        }
+        std::string bytes(MAGIC, sizeof(MAGIC));
+        put<uint32_t>(bytes, VERSION);
+        put<uint32_t>(bytes, static_cast<uint32_t>(messages.size()));
+        put<uint32_t>(bytes, 0);
+        std::size_t tableOffset = bytes.size();
+        bytes.resize(tableOffset + messages.size() * sizeof(uint64_t));
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            uint64_t offset = bytes.size();
+            std::memcpy(&bytes[tableOffset + i * sizeof(uint64_t)], &offset, sizeof(offset));
+            const auto& message = *messages[i];
+            put<int32_t>(bytes, message.getSenderId());
+            put<int32_t>(bytes, message.getReceiverId());
+            put<uint64_t>(bytes, message.getTimestamp().getTicks());
+            put<uint64_t>(bytes, message.getSequence());
+            put<uint8_t>(bytes, message.isRead() ? 1 : 0);
+            put<uint32_t>(bytes, static_cast<uint32_t>(message.getContent().size()));
+            bytes.append(message.getContent());
+        }
+
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        std::error_code error;
+        if (!parent.empty() && !std::filesystem::create_directories(parent, error) && error) {
+            throw FacebookException("Could not create segment directory: " + parent.string(), "FileError");
+        }
+        create(path, bytes);
+        return std::shared_ptr<MessageSegment>(new MessageSegment(
+            path, messages.size(), messages.front()->getTimestamp(), messages.back()->getTimestamp()));
+    }
+
+    // Message i, mapping the file if needed
+    StoredMessage at(std::size_t index) const {
+        map();
+        uint64_t offset = get<uint64_t>(HEADER_SIZE + index * sizeof(uint64_t));
+        if (offset > length || length - offset < FIXED_RECORD_SIZE) {
+            corrupt();
+        }
+        uint32_t contentLength = get<uint32_t>(offset + FIXED_RECORD_SIZE - 4);
+        if (length - offset - FIXED_RECORD_SIZE < contentLength) {
+            corrupt();
+        }
+        return {get<int32_t>(offset), get<int32_t>(offset + 4), DateTime::fromTicks(get<uint64_t>(offset + 8)),
+                get<uint64_t>(offset + 16), get<uint8_t>(offset + 24) != 0,
+                std::string_view(data + offset + FIXED_RECORD_SIZE, contentLength)};
+    }
+
+    // Release the mapping; the next access maps the file again
+    void unmap() const {
+        if (!data) {
+            return;
+        }
+#ifdef _WIN32
+        buffer.clear();
+        buffer.shrink_to_fit();
+#else
+        ::munmap(const_cast<char*>(data), length);
+#endif
+        data = nullptr;
+        length = 0;
+    }
+
+    // Accessors
+    const std::string& getPath() const { return path; }
+    std::size_t size() const { return count; }
+    bool isMapped() const { return data != nullptr; }
+    const DateTime& getOldest() const { return oldest; }
+    const DateTime& getNewest() const { return newest; }
+};
+
+#endif // MESSAGE_SEGMENT_H
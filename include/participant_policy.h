@@ -0,0 +1,90 @@
+#ifndef PARTICIPANT_POLICY_H
+#define PARTICIPANT_POLICY_H
+
+#include "participant_set.h"
+#include <vector>
+#include <algorithm>
+
+// Participant storage policies for Conversation. A policy owns the member
+// list and answers the membership checks on the message path.
+
+// Any number of participants, kept in join order with a ParticipantSet for
+// lookups
+class GroupPolicy {
+private:
+    std::vector<int> participants;
+    ParticipantSet members;
+
+public:
+    // Returns false if an ID is not positive or appears twice
+    bool assign(const std::vector<int>& userIds) {
+        participants = userIds;
+        for (int userId : userIds) {
+            if (userId <= 0 || !members.insert(userId)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool add(int userId) {
+        if (!members.insert(userId)) {
+            return false;
+        }
+        participants.push_back(userId);
+        return true;
+    }
+
+    void remove(int userId) {
+        if (members.erase(userId)) {
+            participants.erase(std::find(participants.begin(), participants.end(), userId));
+        }
+    }
+
+    bool contains(int userId) const { return members.contains(userId); }
+    bool accepts(int senderId, int receiverId) const { return contains(senderId) && contains(receiverId); }
+    const std::vector<int>& getParticipants() const { return participants; }
+};
+
+// Exactly two participants stored inline: no allocation, and a message is
+// checked with two compares
+class DirectPolicy {
+private:
+    int first;
+    int second;
+
+public:
+    DirectPolicy() : first(0), second(0) {}
+
+    // Returns false unless given two distinct positive IDs
+    bool assign(const std::vector<int>& userIds) {
+        if (userIds.size() != 2 || userIds[0] <= 0 || userIds[1] <= 0 || userIds[0] == userIds[1]) {
+            return false;
+        }
+        first = userIds[0];
+        second = userIds[1];
+        return true;
+    }
+
+    bool add(int) { return false; }  // A direct conversation never grows
+
+    void remove(int userId) {
+        if (userId == first) first = 0;
+        if (userId == second) second = 0;
+    }
+
+    bool contains(int userId) const { return userId > 0 && (userId == first || userId == second); }
+    bool accepts(int senderId, int receiverId) const {
+        return senderId > 0 && receiverId > 0 &&
+               ((senderId == first && receiverId == second) || (senderId == second && receiverId == first));
+    }
+
+    std::vector<int> getParticipants() const {
+        std::vector<int> result;
+        if (first > 0) result.push_back(first);
+        if (second > 0) result.push_back(second);
+        return result;
+    }
+};
+
+#endif // PARTICIPANT_POLICY_H
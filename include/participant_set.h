@@ -0,0 +1,82 @@
+#ifndef PARTICIPANT_SET_H
+#define PARTICIPANT_SET_H
+
+#include <array>
+#include <cstddef>
+#include <algorithm>
+#include <unordered_set>
+
+// Membership set for conversation participants. Small groups (the common
+// case) live in a sorted inline array, so a lookup is a handful of compares
+// and no allocation; once the group outgrows the array it moves to a hash
+// set, keeping lookups constant-time for large groups.
+class ParticipantSet {
+private:
+    static constexpr std::size_t INLINE_CAPACITY = 8;
+
+    std::array<int, INLINE_CAPACITY> inlineIds;
+    std::size_t inlineCount;
+    std::unordered_set<int> largeIds;  // Used instead of inlineIds once spilled
+    bool spilled;
+
+    int* inlineEnd() { return inlineIds.data() + inlineCount; }
+    const int* inlineEnd() const { return inlineIds.data() + inlineCount; }
+
+public:
+    ParticipantSet() : inlineIds(), inlineCount(0), spilled(false) {}
+
+    // Returns false if the ID was already present
+    bool insert(int userId) {
+        if (spilled) {
+            return largeIds.insert(userId).second;
+        }
+        int* position = std::lower_bound(inlineIds.data(), inlineEnd(), userId);
+        if (position != inlineEnd() && *position == userId) {
+            return false;
+        }
+        if (inlineCount < INLINE_CAPACITY) {
+            std::copy_backward(position, inlineEnd(), inlineEnd() + 1);
+            *position = userId;
+            ++inlineCount;
+            return true;
+        }
+        largeIds.reserve(INLINE_CAPACITY * 2);
+        largeIds.insert(inlineIds.begin(), inlineIds.end());
+        largeIds.insert(userId);
+        inlineCount = 0;
+        spilled = true;
+        return true;
+    }
+
+    // Returns false if the ID was not present
+    bool erase(int userId) {
+        if (spilled) {
+            return largeIds.erase(userId) > 0;
+        }
+        int* position = std::lower_bound(inlineIds.data(), inlineEnd(), userId);
+        if (position == inlineEnd() || *position != userId) {
+            return false;
+        }
+        std::copy(position + 1, inlineEnd(), position);
+        --inlineCount;
+        return true;
+    }
+
+    bool contains(int userId) const {
+        if (spilled) {
+            return largeIds.count(userId) > 0;
+        }
+        for (std::size_t i = 0; i < inlineCount; ++i) {
+            if (inlineIds[i] >= userId) {
+                return inlineIds[i] == userId;
+            }
+        }
+        return false;
+    }
+
+    std::size_t size() const { return spilled ? largeIds.size() : inlineCount; }
+    bool empty() const { return size() == 0; }
+    bool isInline() const { return !spilled; }
+};
+
+#endif // PARTICIPANT_SET_H
@@ -14,7 +14,6 @@ private:
     std::string content;
     DateTime timestamp;
     std::vector<int> likerIds;  // IDs of users who liked this reply
-    static int nextId;  // For generating unique IDs
 
 public:
     // Constructor
@@ -0,0 +1,65 @@
+#ifndef SLAB_POOL_H
+#define SLAB_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Constructs objects in fixed-size slabs. An object never moves once built,
+// so its address (or index) is a stable handle; a slab is one allocation
+// shared by SLAB_SIZE objects, and everything is released together when the
+// pool is destroyed.
+template<typename T, std::size_t SLAB_SIZE = 1024>
+class SlabPool {
+private:
+    using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    std::size_t count;
+
+    T* slot(std::size_t index) const {
+        return reinterpret_cast<T*>(&slabs[index / SLAB_SIZE][index % SLAB_SIZE]);
+    }
+
+public:
+    SlabPool() : count(0) {}
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    ~SlabPool() {
+        while (count > 0) {
+            popBack();
+        }
+    }
+
+    // Construct a new object at the end of the pool. If the constructor
+    // throws, the pool is left unchanged.
+    template<typename... Args>
+    T* emplace(Args&&... args) {
+        if (count == slabs.size() * SLAB_SIZE) {
+            slabs.emplace_back(new Slot[SLAB_SIZE]);
+        }
+        T* object = new (slot(count)) T(std::forward<Args>(args)...);
+        ++count;
+        return object;
+    }
+
+    // Destroy the most recently constructed object
+    void popBack() {
+        --count;
+        slot(count)->~T();
+    }
+
+    // Accessors
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::size_t slabCount() const { return slabs.size(); }
+    T& operator[](std::size_t index) { return *slot(index); }
+    const T& operator[](std::size_t index) const { return *slot(index); }
+};
+
+#endif // SLAB_POOL_H
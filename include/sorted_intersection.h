@@ -0,0 +1,128 @@
+#ifndef SORTED_INTERSECTION_H
+#define SORTED_INTERSECTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SORTED_INTERSECTION_SSE2 1
+#endif
+
+// Intersection of two strictly increasing uint32_t arrays, such as friend
+// lists in FriendGraph. Lists of similar length are merged, four elements
+// of each side compared at once with SSE2 where available. When one list is
+// much longer, each element of the short one is found by galloping through
+// the long one, which costs O(small * log(large / small)) instead of
+// O(small + large).
+class SortedIntersection {
+public:
+    // Gallop once the longer list is this many times the shorter one
+    static constexpr std::size_t GALLOP_RATIO = 32;
+
+    // Call emit(value) for each value in both arrays, in increasing order
+    template<typename Emit>
+    static void forEach(const uint32_t* a, std::size_t aSize, const uint32_t* b, std::size_t bSize, Emit emit) {
+        if (aSize > bSize) {
+            std::swap(a, b);
+            std::swap(aSize, bSize);
+        }
+        if (aSize == 0) {
+            return;
+        }
+        if (bSize / aSize >= GALLOP_RATIO) {
+            galloping(a, aSize, b, bSize, emit);
+        } else {
+            merge(a, aSize, b, bSize, emit);
+        }
+    }
+
+    // Number of values in both arrays, without building the intersection
+    static std::size_t count(const uint32_t* a, std::size_t aSize, const uint32_t* b, std::size_t bSize) {
+        std::size_t total = 0;
+        forEach(a, aSize, b, bSize, [&total](uint32_t) { ++total; });
+        return total;
+    }
+
+private:
+    // First position at or after from whose value is not below target
+    static std::size_t gallop(const uint32_t* values, std::size_t from, std::size_t size, uint32_t target) {
+        std::size_t step = 1;
+        std::size_t low = from;
+        std::size_t high = from;
+        while (high < size && values[high] < target) {
+            low = high + 1;
+            high += step;
+            step *= 2;
+        }
+        if (high > size) {
+            high = size;
+        }
+        while (low < high) {
+            std::size_t middle = low + (high - low) / 2;
+            if (values[middle] < target) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    template<typename Emit>
+    static void galloping(const uint32_t* small, std::size_t smallSize, const uint32_t* large, std::size_t largeSize,
+                   Emit& emit) {
+        std::size_t position = 0;
+        for (std::size_t i = 0; i < smallSize && position < largeSize; ++i) {
+            position = gallop(large, position, largeSize, small[i]);
+            if (position < largeSize && large[position] == small[i]) {
+                emit(small[i]);
+                ++position;
+            }
+        }
+    }
+
+    template<typename Emit>
+    static void merge(const uint32_t* a, std::size_t aSize, const uint32_t* b, std::size_t bSize, Emit& emit) {
+        std::size_t i = 0;
+        std::size_t j = 0;
+#ifdef SORTED_INTERSECTION_SSE2
+        // Compare a block of four from each side against all rotations of the
+        // other, then advance whichever block ends lower (both on a tie)
+        while (i + 4 <= aSize && j + 4 <= bSize) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+            __m128i matches = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+                _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4E)),
+                             _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(matches));
+            if (mask) {
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (mask >> lane & 1) {
+                        emit(a[i + lane]);
+                    }
+                }
+            }
+            uint32_t aLast = a[i + 3];
+            uint32_t bLast = b[j + 3];
+            i += aLast <= bLast ? 4 : 0;
+            j += bLast <= aLast ? 4 : 0;
+        }
+#endif
+        while (i < aSize && j < bSize) {
+            if (a[i] < b[j]) {
+                ++i;
+            } else if (b[j] < a[i]) {
+                ++j;
+            } else {
+                emit(a[i]);
+                ++i;
+                ++j;
+            }
+        }
+    }
+};
+
+#endif // SORTED_INTERSECTION_H
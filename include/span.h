@@ -0,0 +1,40 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <vector>
+#include <cstddef>
+
+// Non-owning, read-only view over a contiguous run of elements. A span taken
+// from a container is invalidated by the next modification of that container.
+template<typename T>
+class Span {
+private:
+    const T* first;
+    std::size_t count;
+
+public:
+    using const_iterator = const T*;
+
+    Span() : first(nullptr), count(0) {}
+    Span(const T* start, std::size_t length) : first(start), count(length) {}
+    explicit Span(const std::vector<T>& items) : first(items.data()), count(items.size()) {}
+    explicit Span(std::vector<T>&&) = delete;  // Would dangle once the temporary is gone
+
+    // Elements [offset, offset + length), clamped to the span
+    Span subspan(std::size_t offset, std::size_t length) const {
+        if (offset > count) offset = count;
+        if (length > count - offset) length = count - offset;
+        return Span(first + offset, length);
+    }
+
+    // Accessors
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](std::size_t index) const { return first[index]; }
+    const T& front() const { return first[0]; }
+    const T& back() const { return first[count - 1]; }
+    const_iterator begin() const { return first; }
+    const_iterator end() const { return first + count; }
+};
+
+#endif // SPAN_H
@@ -0,0 +1,98 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+
+// Vector kept in ascending order under Less. Elements that arrive in order
+// are appended in O(1); a late element is placed by galloping back from the
+// tail and then binary searching, so its cost grows with how late it is
+// (log d to find, d to shift) rather than with the size of the timeline.
+// Equal elements keep their arrival order.
+template<typename T, typename Less>
+class Timeline {
+private:
+    std::vector<T> items;
+    Less less;
+
+public:
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    explicit Timeline(Less order = Less()) : less(order) {}
+
+    // Insert an element, returning the position it landed at
+    std::size_t insert(const T& item) {
+        if (items.empty() || !less(item, items.back())) {
+            items.push_back(item);
+            return items.size() - 1;
+        }
+
+        // Gallop back from the tail to bracket the insertion point
+        std::size_t high = items.size() - 1;  // items[high] sorts after item
+        std::size_t low = 0;
+        for (std::size_t step = 1;; step *= 2) {
+            low = high >= step ? high - step : 0;
+            if (low == 0 || !less(item, items[low])) {
+                break;
+            }
+            high = low;
+        }
+
+        auto position = std::upper_bound(items.begin() + low, items.begin() + high, item, less);
+        std::size_t index = static_cast<std::size_t>(position - items.begin());
+        items.insert(position, item);
+        return index;
+    }
+
+    // Merge a batch that is already sorted under Less in one linear pass,
+    // in place from the tail. On equal keys the batch goes after existing
+    // elements, as if each had been inserted in turn.
+    void merge(const std::vector<T>& batch) {
+        if (batch.empty()) {
+            return;
+        }
+        if (items.empty() || !less(batch.front(), items.back())) {
+            items.insert(items.end(), batch.begin(), batch.end());
+            return;
+        }
+        std::size_t existing = items.size();
+        items.resize(existing + batch.size());
+        std::size_t out = items.size();
+        std::size_t next = batch.size();
+        while (next > 0) {
+            if (existing > 0 && less(batch[next - 1], items[existing - 1])) {
+                items[--out] = std::move(items[--existing]);
+            } else {
+                items[--out] = batch[--next];
+            }
+        }
+    }
+
+    // Remove the first count elements
+    void eraseFront(std::size_t count) {
+        items.erase(items.begin(), items.begin() + std::min(count, items.size()));
+    }
+
+    // Remove every element matching pred, keeping the rest in order
+    template<typename Predicate>
+    void eraseIf(Predicate pred) {
+        items.erase(std::remove_if(items.begin(), items.end(), pred), items.end());
+    }
+
+    void reserve(std::size_t count) { items.reserve(count); }
+    void clear() { items.clear(); }
+
+    // Accessors
+    const std::vector<T>& getItems() const { return items; }
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    const T& operator[](std::size_t index) const { return items[index]; }
+    const T& front() const { return items.front(); }
+    const T& back() const { return items.back(); }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+};
+
+#endif // TIMELINE_H
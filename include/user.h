@@ -4,9 +4,10 @@
 #include "datetime.h"
 #include "post.h"
 #include "facebook_exception.h"
+#include "friend_graph.h"
+#include "common_posts.h"
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <algorithm>
 
 class User {
@@ -17,7 +18,8 @@ private:
     std::string gender;
     DateTime birthdate;
     std::vector<Post*> posts;
-    std::unordered_map<User*, bool> friends;  // bool indicates if restricted (true) or regular (false)
+    std::vector<PostRef> postIndex;  // Same posts, sorted by ID for common-post lookups
+    FriendGraph::NodeId graphId;  // Node in FriendGraph, which holds this user's friendships
 
     bool isValidEmail(const std::string& email) const;
     void validateFields() const;
@@ -27,23 +29,36 @@ public:
     User(const std::string& email, const std::string& name, const std::string& password,
          const std::string& gender, const DateTime& birthdate);
     
+    // A copy is a new user in the friend graph with no friendships, and
+    // assigning a copy keeps the target's own; neither touches other users.
+    // A move hands the graph node, and so the friendships, to the new object.
+    User(const User& other);
+    User(User&& other) noexcept;
+    User& operator=(const User& other);
+    User& operator=(User&& other);
+    ~User();
+    
     // Getters
     std::string getEmail() const { return email; }
     std::string getName() const { return name; }
     std::string getGender() const { return gender; }
     DateTime getBirthdate() const { return birthdate; }
+    FriendGraph::NodeId getGraphId() const { return graphId; }
     std::vector<Post*> getPosts() const { return posts; }
     
     // Password management
     bool validatePassword(const std::string& password) const;
     void changePassword(const std::string& oldPassword, const std::string& newPassword);
     
-    // Friend management
+    // Friend management. Friendships are mutual; restricted is this user's
+    // flag for the friend and hides friends-only posts from them.
     void addFriend(User* user, bool restricted = false);
     void removeFriend(User* user);
+    FriendGraph::Relation getRelation(const User* user) const;  // One lookup for both checks below
     bool isFriend(const User* user) const;
     bool isRestrictedFriend(const User* user) const;
-    std::vector<User*> getFriends(bool restricted = false) const;
+    // Regular or restricted friends, not copied; valid until the next friendship change
+    FriendGraph::UserList getFriends(bool restricted = false) const;
     
     // Post management
     void addPost(Post* post);
@@ -51,8 +66,10 @@ public:
     std::vector<Post*> getVisiblePosts(const User* viewer) const;
     
     // Operator overloading
-    std::vector<Post*> operator+(const User& other) const;  // Common posts
+    CommonPosts operator+(const User& other) const;  // Common posts, as a lazy view
     std::vector<User*> operator&(const User& other) const;  // Mutual friends
+    std::size_t countMutualFriends(const User& other) const;  // Same, for "N mutual friends" badges
+    std::vector<User*> suggestFriends(std::size_t limit) const;  // People this user may know, best first
     
     // User search
     static std::vector<User*> searchUsers(const std::vector<User*>& users, const std::string& query);
@@ -1,14 +1,13 @@
 #include "../include/comment.h"
 #include "../include/reply.h"
+#include "../include/clock.h"
+#include "../include/id_generator.h"
 #include <sstream>
 #include <algorithm>
 
-// Initialize static member
-int Comment::nextId = 1;
-
 Comment::Comment(int authorId, const std::string& content)
-    : id(nextId++), authorId(authorId), content(content),
-      timestamp(DateTime(2025, 1, 2, 0, 47, 41))  // Current time from context
+    : id(IdGenerator<Comment>::next()), authorId(authorId), content(content),
+      timestamp(Clock::getInstance().now())
 {
     if (!isValid()) {
         throw FacebookException("Invalid comment parameters", "ValidationError");
@@ -1,13 +1,12 @@
 #include "../include/datetime.h"
-#include <sstream>
-#include <iomanip>
 
-int DateTime::getDay() const { return day; }
-int DateTime::getMonth() const { return month; }
-int DateTime::getYear() const { return year; }
-int DateTime::getHour() const { return hour; }
-int DateTime::getMinute() const { return minute; }
-int DateTime::getSecond() const { return second; }
+int DateTime::getDay() const { return unpack(DAY_SHIFT, 5); }
+int DateTime::getMonth() const { return unpack(MONTH_SHIFT, 4); }
+int DateTime::getYear() const { return unpack(YEAR_SHIFT, 18) - YEAR_BIAS; }
+int DateTime::getHour() const { return unpack(HOUR_SHIFT, 5); }
+int DateTime::getMinute() const { return unpack(MINUTE_SHIFT, 6); }
+int DateTime::getSecond() const { return unpack(SECOND_SHIFT, 6); }
+int DateTime::getMicrosecond() const { return unpack(0, SUBSECOND_BITS); }
 
 bool DateTime::isLeapYear(int year) const {
     return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
@@ -22,11 +21,14 @@ int DateTime::getDaysInMonth(int month, int year) const {
 }
 
 bool DateTime::isValid() const {
+    int day = getDay(), month = getMonth(), year = getYear();
+    int hour = getHour(), minute = getMinute(), second = getSecond();
     if (month < 1 || month > 12) return false;
     if (day < 1 || day > getDaysInMonth(month, year)) return false;
     if (hour < 0 || hour > 23) return false;
     if (minute < 0 || minute > 59) return false;
     if (second < 0 || second > 59) return false;
+    if (getMicrosecond() > 999999) return false;
     return true;
 }
 
@@ -34,44 +36,153 @@ std::string DateTime::toString() const {
     return serialize();
 }
 
-std::string DateTime::serialize() const {
-    std::ostringstream ss;
-    ss << year << '-'
-       << std::setw(2) << std::setfill('0') << month << '-'
-       << std::setw(2) << std::setfill('0') << day << ' '
-       << std::setw(2) << std::setfill('0') << hour << ':'
-       << std::setw(2) << std::setfill('0') << minute << ':'
-       << std::setw(2) << std::setfill('0') << second;
-    return ss.str();
+int64_t DateTime::toEpochSeconds() const {
+    // Days from civil date (proleptic Gregorian), shifted so March is month 0
+    int year = getYear(), month = getMonth();
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yoe = year - era * 400;
+    const int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + getDay() - 1;
+    const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    const int64_t days = era * 146097 + doe - 719468;
+    return days * 86400 + getHour() * 3600 + getMinute() * 60 + getSecond();
 }
 
-DateTime DateTime::deserialize(const std::string& data) {
-    std::istringstream ss(data);
-    char delimiter;
-    int year, month, day, hour = 0, minute = 0, second = 0;
-    
-    ss >> year >> delimiter >> month >> delimiter >> day;
-    
-    if (ss >> delimiter) {  // If there's more data (time)
-        ss >> hour >> delimiter >> minute >> delimiter >> second;
+// Writes a non-negative value below 100 as exactly two digits
+static char* writeTwoDigits(char* out, int value) {
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+    return out + 2;
+}
+
+// Longest digit run readInt() accepts, which keeps clear of int overflow
+static constexpr std::size_t MAX_INT_DIGITS = 9;
+
+// Reads an optionally signed decimal integer, advancing pos past it
+static bool readInt(std::string_view text, std::size_t& pos, int& value) {
+    bool negative = false;
+    if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+        negative = text[pos] == '-';
+        ++pos;
+    }
+    std::size_t start = pos;
+    int result = 0;
+    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+        if (pos - start == MAX_INT_DIGITS) return false;
+        result = result * 10 + (text[pos] - '0');
+        ++pos;
     }
-    
-    return DateTime(day, month, year, hour, minute, second);
+    if (pos == start) return false;
+    value = negative ? -result : result;
+    return true;
 }
 
-bool DateTime::operator<(const DateTime& other) const {
-    if (year != other.year) return year < other.year;
-    if (month != other.month) return month < other.month;
-    if (day != other.day) return day < other.day;
-    if (hour != other.hour) return hour < other.hour;
-    if (minute != other.minute) return minute < other.minute;
-    return second < other.second;
+static bool readSeparator(std::string_view text, std::size_t& pos, char expected) {
+    if (pos < text.size() && text[pos] == expected) {
+        ++pos;
+        return true;
+    }
+    return false;
 }
 
-bool DateTime::operator>(const DateTime& other) const {
-    return other < *this;
+std::size_t DateTime::formatTo(char* buffer) const {
+    char* out = buffer;
+    int year = getYear();
+    if (year < 0) {
+        *out++ = '-';
+        year = -year;
+    }
+    char digits[8];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + year % 10);
+        year /= 10;
+    } while (year > 0);
+    while (count > 0) {
+        *out++ = digits[--count];
+    }
+    *out++ = '-';
+    out = writeTwoDigits(out, getMonth());
+    *out++ = '-';
+    out = writeTwoDigits(out, getDay());
+    *out++ = ' ';
+    out = writeTwoDigits(out, getHour());
+    *out++ = ':';
+    out = writeTwoDigits(out, getMinute());
+    *out++ = ':';
+    out = writeTwoDigits(out, getSecond());
+    int microsecond = getMicrosecond();
+    if (microsecond != 0) {
+        *out++ = '.';
+        for (int i = 5; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + microsecond % 10);
+            microsecond /= 10;
+        }
+        out += 6;
+    }
+    return static_cast<std::size_t>(out - buffer);
 }
 
-bool DateTime::operator==(const DateTime& other) const {
-    return !(*this < other) && !(other < *this);
+bool DateTime::parse(std::string_view text, DateTime& result) {
+    std::size_t pos = 0;
+    while (pos < text.size() && text[pos] == ' ') ++pos;
+
+    int year, month, day, hour = 0, minute = 0, second = 0, microsecond = 0;
+    if (!readInt(text, pos, year) || !readSeparator(text, pos, '-') ||
+        !readInt(text, pos, month) || !readSeparator(text, pos, '-') ||
+        !readInt(text, pos, day)) {
+        return false;
+    }
+
+    if (readSeparator(text, pos, ' ') || readSeparator(text, pos, 'T')) {
+        if (!readInt(text, pos, hour) || !readSeparator(text, pos, ':') ||
+            !readInt(text, pos, minute) || !readSeparator(text, pos, ':') ||
+            !readInt(text, pos, second)) {
+            return false;
+        }
+        if (readSeparator(text, pos, '.')) {
+            // Fraction of a second, scaled to microseconds; digits past
+            // the sixth (up to nanoseconds) are dropped
+            std::size_t start = pos;
+            int digits = 0;
+            while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+                if (pos - start == MAX_INT_DIGITS) return false;
+                if (digits < 6) {
+                    microsecond = microsecond * 10 + (text[pos] - '0');
+                    ++digits;
+                }
+                ++pos;
+            }
+            if (digits == 0) return false;
+            for (; digits < 6; ++digits) microsecond *= 10;
+        }
+    }
+    if (pos != text.size()) {
+        return false;  // Trailing garbage
+    }
+
+    result = DateTime(day, month, year, hour, minute, second, microsecond);
+    return true;
+}
+
+std::string DateTime::serialize() const {
+    char buffer[MAX_SERIALIZED_LENGTH];
+    return std::string(buffer, formatTo(buffer));
+}
+
+DateTime DateTime::deserialize(const std::string& data) {
+    DateTime result(0, 0, 0);
+    parse(data, result);
+    return result;
+}
+
+std::vector<DateTime> DateTime::deserializeBatch(const std::vector<std::string>& data) {
+    std::vector<DateTime> result;
+    result.reserve(data.size());
+    for (const std::string& text : data) {
+        DateTime dt(0, 0, 0);
+        parse(text, dt);
+        result.push_back(dt);
+    }
+    return result;
 }
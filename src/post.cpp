@@ -2,12 +2,13 @@
 #include "../include/user.h"
 #include "../include/comment.h"
 #include "../include/facebook_exception.h"
+#include "../include/clock.h"
 #include <sstream>
 #include <algorithm>
 
 Post::Post(int id, const std::string& content, Privacy privacy, User* author)
     : id(id), content(content), privacy(privacy), author(author), 
-      createdAt(DateTime(2025, 1, 2, 2, 37, 2)) {  // Current time from context
+      createdAt(Clock::getInstance().now()) {
     if (!author || content.empty()) {
         throw FacebookException("Invalid post parameters", "ValidationError");
     }
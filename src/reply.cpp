@@ -1,13 +1,12 @@
 #include "../include/reply.h"
+#include "../include/clock.h"
+#include "../include/id_generator.h"
 #include <sstream>
 #include <algorithm>
 
-// Initialize static member
-int Reply::nextId = 1;
-
 Reply::Reply(int authorId, int commentId, const std::string& content)
-    : id(nextId++), authorId(authorId), commentId(commentId), 
-      content(content), timestamp(DateTime(2025, 1, 2, 0, 47, 41))  // Current time from context
+    : id(IdGenerator<Reply>::next()), authorId(authorId), commentId(commentId), 
+      content(content), timestamp(Clock::getInstance().now())
 {
     if (!isValid()) {
         throw FacebookException("Invalid reply parameters", "ValidationError");
@@ -1,7 +1,9 @@
 #include "../include/user.h"
+#include "../include/friend_suggester.h"
 #include <regex>
 #include <algorithm>
 #include <sstream>
+#include <utility>
 
 bool User::isValidEmail(const std::string& email) const {
     // Basic email validation using regex
@@ -40,6 +42,64 @@ User::User(const std::string& email, const std::string& name, const std::string&
     : email(email), name(name), gender(gender), birthdate(birthdate) {
     this->password = hashPassword(password);
     validateFields();
+    graphId = FriendGraph::getInstance().addUser(this);
+}
+
+User::User(const User& other)
+    : email(other.email), name(other.name), password(other.password), gender(other.gender),
+      birthdate(other.birthdate), posts(other.posts), postIndex(other.postIndex) {
+    graphId = FriendGraph::getInstance().addUser(this);
+}
+
+User::User(User&& other) noexcept
+    : email(std::move(other.email)), name(std::move(other.name)), password(std::move(other.password)),
+      gender(std::move(other.gender)), birthdate(other.birthdate), posts(std::move(other.posts)),
+      postIndex(std::move(other.postIndex)), graphId(other.graphId) {
+    if (graphId != FriendGraph::NO_NODE) {
+        FriendGraph::getInstance().relinkUser(graphId, this);
+    }
+    other.graphId = FriendGraph::NO_NODE;
+}
+
+User& User::operator=(const User& other) {
+    if (this != &other) {
+        email = other.email;
+        name = other.name;
+        password = other.password;
+        gender = other.gender;
+        birthdate = other.birthdate;
+        posts = other.posts;
+        postIndex = other.postIndex;
+    }
+    return *this;
+}
+
+User& User::operator=(User&& other) {
+    if (this != &other) {
+        FriendGraph& graph = FriendGraph::getInstance();
+        if (graphId != FriendGraph::NO_NODE) {
+            graph.removeUser(graphId);
+        }
+        email = std::move(other.email);
+        name = std::move(other.name);
+        password = std::move(other.password);
+        gender = std::move(other.gender);
+        birthdate = other.birthdate;
+        posts = std::move(other.posts);
+        postIndex = std::move(other.postIndex);
+        graphId = other.graphId;
+        if (graphId != FriendGraph::NO_NODE) {
+            graph.relinkUser(graphId, this);
+        }
+        other.graphId = FriendGraph::NO_NODE;
+    }
+    return *this;
+}
+
+User::~User() {
+    if (graphId != FriendGraph::NO_NODE) {  // Moved-from users have no node
+        FriendGraph::getInstance().removeUser(graphId);
+    }
 }
 
 bool User::validatePassword(const std::string& password) const {
@@ -55,38 +115,37 @@ void User::changePassword(const std::string& oldPassword, const std::string& new
 
 void User::addFriend(User* user, bool restricted) {
     if (user && user != this) {
-        friends[user] = restricted;
+        FriendGraph::getInstance().addFriendship(graphId, user->graphId, restricted);
     }
 }
 
 void User::removeFriend(User* user) {
     if (user) {
-        friends.erase(user);
+        FriendGraph::getInstance().removeFriendship(graphId, user->graphId);
     }
 }
 
+FriendGraph::Relation User::getRelation(const User* user) const {
+    return user ? FriendGraph::getInstance().getRelation(graphId, user->graphId) : FriendGraph::Relation::None;
+}
+
 bool User::isFriend(const User* user) const {
-    return friends.find(const_cast<User*>(user)) != friends.end();
+    return getRelation(user) != FriendGraph::Relation::None;
 }
 
 bool User::isRestrictedFriend(const User* user) const {
-    auto it = friends.find(const_cast<User*>(user));
-    return it != friends.end() && it->second;
+    return getRelation(user) == FriendGraph::Relation::Restricted;
 }
 
-std::vector<User*> User::getFriends(bool restricted) const {
-    std::vector<User*> result;
-    for (const auto& pair : friends) {
-        if (pair.second == restricted) {
-            result.push_back(pair.first);
-        }
-    }
-    return result;
+FriendGraph::UserList User::getFriends(bool restricted) const {
+    return FriendGraph::getInstance().getFriendUsers(graphId, restricted);
 }
 
 void User::addPost(Post* post) {
     if (post) {
         posts.push_back(post);
+        PostRef ref{post->getId(), post};
+        postIndex.insert(std::upper_bound(postIndex.begin(), postIndex.end(), ref), ref);
     }
 }
 
@@ -94,16 +153,19 @@ void User::removePost(Post* post) {
     auto it = std::find(posts.begin(), posts.end(), post);
     if (it != posts.end()) {
         posts.erase(it);
+        // Found by pointer: the post may already be destroyed
+        postIndex.erase(std::find_if(postIndex.begin(), postIndex.end(),
+                                     [post](const PostRef& ref) { return ref.post == post; }));
     }
 }
 
 std::vector<Post*> User::getVisiblePosts(const User* viewer) const {
     std::vector<Post*> visiblePosts;
+    // The viewer is the same for every post, so look the relationship up once
+    bool seesFriendsOnly = viewer == this || getRelation(viewer) == FriendGraph::Relation::Regular;
     
     for (Post* post : posts) {
-        if (post->getPrivacy() == Post::Privacy::Public || 
-            viewer == this || 
-            (isFriend(viewer) && !isRestrictedFriend(viewer))) {
+        if (post->getPrivacy() == Post::Privacy::Public || seesFriendsOnly) {
             visiblePosts.push_back(post);
         }
     }
@@ -137,33 +199,32 @@ std::string User::serialize() const {
     return ss.str();
 }
 
-std::vector<Post*> User::operator+(const User& other) const {
-    std::vector<Post*> commonPosts;
-    
-    for (Post* myPost : posts) {
-        for (Post* theirPost : other.posts) {
-            if (myPost == theirPost) {  // Same post object
-                commonPosts.push_back(myPost);
-            }
-        }
-    }
-    
-    return commonPosts;
+CommonPosts User::operator+(const User& other) const {
+    return CommonPosts(Span<PostRef>(postIndex), Span<PostRef>(other.postIndex));
 }
 
 std::vector<User*> User::operator&(const User& other) const {
     std::vector<User*> mutualFriends;
-    
-    for (const auto& myFriend : friends) {
-        User* user = myFriend.first;
-        if (other.isFriend(user) && user != this && user != &other) {
-            mutualFriends.push_back(user);
-        }
-    }
-    
+    const FriendGraph& graph = FriendGraph::getInstance();
+    graph.forEachMutualFriend(graphId, other.graphId, [&](FriendGraph::NodeId friendId) {
+        mutualFriends.push_back(graph.getUser(friendId));
+    });
     return mutualFriends;
 }
 
+std::size_t User::countMutualFriends(const User& other) const {
+    return FriendGraph::getInstance().countMutualFriends(graphId, other.graphId);
+}
+
+std::vector<User*> User::suggestFriends(std::size_t limit) const {
+    const FriendGraph& graph = FriendGraph::getInstance();
+    std::vector<User*> suggestions;
+    for (const auto& suggestion : FriendSuggester(graph).suggestFor(graphId, limit)) {
+        suggestions.push_back(graph.getUser(suggestion.user));
+    }
+    return suggestions;
+}
+
 std::vector<User*> User::searchUsers(const std::vector<User*>& users, const std::string& query) {
     std::vector<User*> results;
     std::string lowerQuery = query;
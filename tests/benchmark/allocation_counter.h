@@ -0,0 +1,38 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions so a benchmark can count heap
+// allocations and bytes, including node and bucket overheads that sizeof
+// misses. Include it from one translation unit per benchmark binary.
+//
+// Every replaced operator delete frees with std::free, matching the
+// std::malloc in operator new. They are kept out of line so the compiler
+// does not pair an inlined std::free with a call to operator new.
+struct AllocationCounter {
+    static inline std::size_t bytes = 0;
+    static inline std::size_t count = 0;
+};
+
+#if defined(__GNUC__)
+#define ALLOCATION_COUNTER_NOINLINE __attribute__((noinline))
+#else
+#define ALLOCATION_COUNTER_NOINLINE
+#endif
+
+ALLOCATION_COUNTER_NOINLINE void* operator new(std::size_t size) {
+    AllocationCounter::bytes += size;
+    ++AllocationCounter::count;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+ALLOCATION_COUNTER_NOINLINE void* operator new[](std::size_t size) { return operator new(size); }
+ALLOCATION_COUNTER_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+ALLOCATION_COUNTER_NOINLINE void operator delete[](void* p) noexcept { std::free(p); }
+ALLOCATION_COUNTER_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+ALLOCATION_COUNTER_NOINLINE void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#endif // ALLOCATION_COUNTER_H
@@ -0,0 +1,59 @@
+#include "../../include/columnar_message_store.h"
+#include "../../include/message.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Build with -O2 (SSE2) and again with -O2 -mavx2 to compare kernels.
+// Default is 10M messages; pass a smaller count on memory-limited machines.
+
+template<typename Func>
+double msFor(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    const int groupSize = 50;
+
+    // Array-of-structures layout, as Conversation stores it
+    std::vector<std::shared_ptr<Message>> messages;
+    messages.reserve(count);
+    ColumnarMessageStore store;
+    store.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto message = std::make_shared<Message>(1 + static_cast<int>(i % groupSize),
+                                                 1 + static_cast<int>((i * 31) % groupSize), "Benchmark");
+        if (i % 4 != 0) message->markAsRead();
+        store.append(*message);
+        messages.push_back(std::move(message));
+    }
+
+    size_t aosSender = 0, aosUnread = 0, colSender = 0, colUnread = 0;
+    double aosSenderMs = msFor([&]() {
+        for (const auto& message : messages) aosSender += message->getSenderId() == 7;
+    });
+    double aosUnreadMs = msFor([&]() {
+        for (const auto& message : messages) aosUnread += message->getReceiverId() == 7 && !message->isRead();
+    });
+    double colSenderMs = msFor([&]() {
+        colSender = ColumnarMessageStore::countMatches(store.matchSender(7));
+    });
+    double colUnreadMs = msFor([&]() {
+        colUnread = ColumnarMessageStore::countMatches(store.matchUnread(7));
+    });
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Columnar vs AoS filters (" << count << " messages, kernel "
+              << ColumnarMessageStore::simdLevel() << ")\n"
+              << "  by sender  AoS " << aosSenderMs << " ms  columnar " << colSenderMs << " ms"
+              << "  (" << aosSender << "/" << colSender << " matches)\n"
+              << "  unread     AoS " << aosUnreadMs << " ms  columnar " << colUnreadMs << " ms"
+              << "  (" << aosUnread << "/" << colUnread << " matches)\n";
+    return aosSender == colSender && aosUnread == colUnread ? 0 : 1;
+}
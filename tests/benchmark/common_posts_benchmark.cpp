@@ -0,0 +1,80 @@
+#include "../../include/user.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+template<typename Function>
+double usPerCall(int rounds, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        function();
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / rounds;
+}
+
+// Common posts of two users with aSize and bSize posts, a tenth of the
+// shorter list shared
+void compare(const std::vector<std::unique_ptr<Post>>& pool, std::mt19937& rng, size_t aSize, size_t bSize,
+             int rounds) {
+    User a("a@bench.com", "Bench A", "pass123", "Male", DateTime(1, 1, 1990));
+    User b("b@bench.com", "Bench B", "pass123", "Male", DateTime(1, 1, 1990));
+    std::vector<size_t> order(pool.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+    size_t shared = std::min(aSize, bSize) / 10;
+    for (size_t i = 0; i < aSize; ++i) a.addPost(pool[order[i]].get());
+    for (size_t i = 0; i < bSize; ++i) b.addPost(pool[order[i < shared ? i : aSize + i]].get());
+    std::vector<Post*> aPosts = a.getPosts();
+    std::vector<Post*> bPosts = b.getPosts();
+    size_t sink = 0;
+
+    // The nested loop operator+ used to run
+    double nestedUs = usPerCall(rounds, [&]() {
+        std::vector<Post*> common;
+        for (Post* mine : aPosts) {
+            for (Post* theirs : bPosts) {
+                if (mine == theirs) common.push_back(mine);
+            }
+        }
+        sink += common.size();
+    });
+    // Hash set built for the shorter side on every call
+    double hashUs = usPerCall(rounds, [&]() {
+        const auto& shorter = aPosts.size() <= bPosts.size() ? aPosts : bPosts;
+        const auto& longer = aPosts.size() <= bPosts.size() ? bPosts : aPosts;
+        std::unordered_set<Post*> seen(shorter.begin(), shorter.end());
+        std::vector<Post*> common;
+        for (Post* post : longer) {
+            if (seen.count(post)) common.push_back(post);
+        }
+        sink += common.size();
+    });
+    double viewUs = usPerCall(rounds, [&]() { sink += std::vector<Post*>(a + b).size(); });
+    double countUs = usPerCall(rounds, [&]() { sink += (a + b).count(); });
+    double firstUs = usPerCall(rounds, [&]() { sink += *(a + b).begin() != nullptr; });
+
+    std::cout << "  " << std::setw(6) << aSize << " x " << std::setw(6) << bSize << " posts, " << shared << " common"
+              << "  nested " << nestedUs << "  hash set " << hashUs << "  view to vector " << viewUs
+              << "  view count " << countUs << "  first only " << firstUs << "  (us, sink " << sink % 10 << ")\n";
+}
+
+int main(int argc, char** argv) {
+    size_t posts = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    User author("author@bench.com", "Bench Author", "pass123", "Female", DateTime(1, 1, 1990));
+    std::vector<std::unique_ptr<Post>> pool;
+    for (size_t i = 0; i < posts * 3; ++i) {
+        pool.push_back(std::make_unique<Post>(static_cast<int>(i), "Post", Post::Privacy::Public, &author));
+    }
+    std::mt19937 rng(8);
+
+    std::cout << std::fixed << std::setprecision(2) << "Common posts (operator+)\n";
+    compare(pool, rng, posts, posts, 5);
+    compare(pool, rng, posts / 100, posts, 200);  // Skewed: the view searches the longer index
+    compare(pool, rng, posts / 10, posts, 50);
+    return 0;
+}
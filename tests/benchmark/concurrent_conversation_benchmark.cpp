@@ -0,0 +1,73 @@
+#include "../../include/concurrent_conversation.h"
+#include "../../include/conversation.h"
+#include "../../include/message.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using MessageBatch = std::vector<std::shared_ptr<Message>>;
+
+// Run one append loop per thread and return millions of appends per second
+template<typename Append>
+double throughput(const std::vector<MessageBatch>& batches, Append append) {
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& batch : batches) {
+        threads.emplace_back([&batch, &append]() {
+            for (const auto& message : batch) append(message);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return batches.size() * batches[0].size() / seconds / 1e6;
+}
+
+int main(int argc, char** argv) {
+    size_t perThread = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const int maxThreads = 32;
+
+    std::vector<int> participants;
+    for (int id = 1; id <= maxThreads + 1; ++id) participants.push_back(id);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Concurrent append throughput (" << perThread << " messages/thread, M appends/s, "
+              << std::thread::hardware_concurrency() << " hardware threads)\n"
+              << "  threads  lock-free  mutex+Conversation\n";
+
+    // Warm up the allocator and thread startup so the single-thread row is not penalised
+    {
+        ConcurrentConversation<Message> warmup(participants);
+        for (size_t i = 0; i < perThread; ++i) {
+            warmup.addMessage(std::make_shared<Message>(1, 2, "Warmup"));
+        }
+    }
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::vector<MessageBatch> batches(threads);
+        for (int t = 0; t < threads; ++t) {
+            for (size_t i = 0; i < perThread; ++i) {
+                batches[t].push_back(std::make_shared<Message>(t + 1, maxThreads + 1, "Benchmark"));
+            }
+        }
+
+        ConcurrentConversation<Message> concurrent(participants, perThread * threads);
+        double lockFree = throughput(batches, [&](const std::shared_ptr<Message>& message) {
+            concurrent.addMessage(message);
+        });
+
+        Conversation<Message> guarded(participants);
+        std::mutex mutex;
+        double locked = throughput(batches, [&](const std::shared_ptr<Message>& message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            guarded.addMessage(message);
+        });
+
+        std::cout << "  " << std::setw(7) << threads << "  " << std::setw(9) << lockFree
+                  << "  " << std::setw(18) << locked << "\n";
+    }
+    return 0;
+}
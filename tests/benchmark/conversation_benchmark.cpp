@@ -0,0 +1,87 @@
+#include "../../include/conversation.h"
+#include "../../include/message.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using MessageList = std::vector<std::shared_ptr<Message>>;
+
+// Messages stamped in send order; every lateEvery-th one is held back a few
+// slots so it reaches the conversation after newer messages
+MessageList makeMessages(size_t count, size_t lateEvery) {
+    MessageList messages;
+    messages.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        messages.push_back(std::make_shared<Message>(1 + i % 2, 2 - i % 2, "Benchmark message"));
+    }
+    if (lateEvery > 0) {
+        for (size_t i = lateEvery; i + 8 < count; i += lateEvery) {
+            std::rotate(messages.begin() + i, messages.begin() + i + 1, messages.begin() + i + 8);
+        }
+    }
+    return messages;
+}
+
+template<typename Func>
+double msFor(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Previous behaviour: push_back followed by a full sort on every insert
+double buildResorting(const MessageList& messages) {
+    return msFor([&]() {
+        MessageList stored;
+        for (const auto& message : messages) {
+            stored.push_back(message);
+            std::sort(stored.begin(), stored.end(), MessageOrder());
+        }
+    });
+}
+
+double buildTimeline(const MessageList& messages) {
+    return msFor([&]() {
+        Conversation<Message> conversation({1, 2});
+        for (const auto& message : messages) {
+            conversation.addMessage(message);
+        }
+    });
+}
+
+double buildBulk(const MessageList& messages) {
+    return msFor([&]() {
+        Conversation<Message> conversation({1, 2});
+        conversation.addMessages(messages);
+    });
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t resortCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Conversation build benchmark (ns/message)\n";
+
+    for (size_t lateEvery : {size_t(0), size_t(100), count}) {
+        const char* label = lateEvery == count ? "shuffled" : lateEvery ? "1% late" : "in order";
+        MessageList messages = makeMessages(count, lateEvery == count ? 0 : lateEvery);
+        if (lateEvery == count) {
+            std::shuffle(messages.begin(), messages.end(), std::mt19937(42));
+        }
+        MessageList small(messages.begin(), messages.begin() + std::min(resortCount, count));
+
+        double timelineMs = lateEvery == count ? buildTimeline(small) * count / small.size() : buildTimeline(messages);
+        double bulkMs = buildBulk(messages);
+        double resortMs = buildResorting(small);
+        std::cout << "  " << label << ": timeline " << count << " msgs: "
+                  << timelineMs * 1e6 / count << "  bulk: " << bulkMs * 1e6 / count
+                  << "  re-sort " << small.size() << " msgs: " << resortMs * 1e6 / small.size() << "\n";
+    }
+    return 0;
+}
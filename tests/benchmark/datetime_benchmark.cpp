@@ -0,0 +1,81 @@
+#include "../../include/datetime.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// Stream-based DateTime serialization used before the buffer formatter,
+// kept here as the baseline
+std::string streamSerialize(const DateTime& dt) {
+    std::ostringstream ss;
+    ss << dt.getYear() << '-'
+       << std::setw(2) << std::setfill('0') << dt.getMonth() << '-'
+       << std::setw(2) << std::setfill('0') << dt.getDay() << ' '
+       << std::setw(2) << std::setfill('0') << dt.getHour() << ':'
+       << std::setw(2) << std::setfill('0') << dt.getMinute() << ':'
+       << std::setw(2) << std::setfill('0') << dt.getSecond();
+    return ss.str();
+}
+
+DateTime streamDeserialize(const std::string& data) {
+    std::istringstream ss(data);
+    char delimiter;
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    ss >> year >> delimiter >> month >> delimiter >> day;
+    if (ss >> delimiter) {
+        ss >> hour >> delimiter >> minute >> delimiter >> second;
+    }
+    return DateTime(day, month, year, hour, minute, second);
+}
+
+template<typename Func>
+double nsPerRecord(size_t count, Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / count;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    std::vector<DateTime> dates;
+    dates.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        dates.emplace_back(1 + i % 28, 1 + i % 12, 1990 + i % 40, i % 24, i % 60, (i / 7) % 60);
+    }
+
+    std::vector<std::string> texts(count);
+    size_t checksum = 0;
+
+    double streamFormat = nsPerRecord(count, [&]() {
+        for (size_t i = 0; i < count; ++i) texts[i] = streamSerialize(dates[i]);
+    });
+    double bufferFormat = nsPerRecord(count, [&]() {
+        char buffer[DateTime::MAX_SERIALIZED_LENGTH];
+        for (size_t i = 0; i < count; ++i) checksum += dates[i].formatTo(buffer) + buffer[3];
+    });
+    double streamParse = nsPerRecord(count, [&]() {
+        for (size_t i = 0; i < count; ++i) checksum += streamDeserialize(texts[i]).getTicks() & 1;
+    });
+    double viewParse = nsPerRecord(count, [&]() {
+        DateTime dt(0, 0, 0);
+        for (size_t i = 0; i < count; ++i) {
+            DateTime::parse(texts[i], dt);
+            checksum += dt.getTicks() & 1;
+        }
+    });
+    double batchParse = nsPerRecord(count, [&]() {
+        checksum += DateTime::deserializeBatch(texts).size();
+    });
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "DateTime benchmark (" << count << " records, ns/record)\n"
+              << "  serialize   stream: " << streamFormat << "  buffer: " << bufferFormat << "\n"
+              << "  deserialize stream: " << streamParse << "  view:   " << viewParse
+              << "  batch: " << batchParse << "\n"
+              << "  (checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "../../include/conversation.h"
+#include "../../include/message.h"
+#include "allocation_counter.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// A message belongs to one conversation (adding it sets its sequence), so
+// each conversation gets its own. Building them is kept out of the timings
+// and the heap figures.
+std::vector<std::shared_ptr<Message>> makeMessages(size_t count) {
+    std::vector<std::shared_ptr<Message>> messages;
+    messages.reserve(count);
+    for (size_t m = 0; m < count; ++m) {
+        messages.push_back(std::make_shared<Message>(1 + m % 2, 2 - m % 2, "Benchmark message"));
+    }
+    return messages;
+}
+
+template<typename ConversationType>
+void run(const char* label, size_t conversations, size_t messagesPerConversation) {
+    std::vector<std::unique_ptr<ConversationType>> store;
+    store.reserve(conversations);
+
+    size_t before = AllocationCounter::bytes;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < conversations; ++i) {
+        store.push_back(std::make_unique<ConversationType>(std::vector<int>{1, 2}));
+    }
+    double createNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    size_t emptyBytes = AllocationCounter::bytes - before;
+
+    double addNs = 0;
+    size_t messageBytes = 0;
+    for (size_t i = 0; i < conversations; ++i) {
+        size_t beforeMessages = AllocationCounter::bytes;
+        std::vector<std::shared_ptr<Message>> messages = makeMessages(messagesPerConversation);
+        messageBytes += AllocationCounter::bytes - beforeMessages;
+        start = std::chrono::steady_clock::now();
+        for (const auto& message : messages) {
+            store[i]->addMessage(message);
+        }
+        addNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::cout << "  " << std::setw(6) << label
+              << "  sizeof " << sizeof(ConversationType)
+              << "  empty heap/conv " << emptyBytes / conversations
+              << "  create ns/conv " << createNs / conversations
+              << "  addMessage ns/msg " << addNs / (conversations * messagesPerConversation)
+              << "  total heap/conv " << (AllocationCounter::bytes - before - messageBytes) / conversations << "\n";
+}
+
+int main(int argc, char** argv) {
+    size_t conversations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t messagesPerConversation = 20;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Direct vs group conversation (" << conversations << " conversations, "
+              << messagesPerConversation << " messages each)\n";
+    run<Conversation<Message, GroupPolicy>>("group", conversations, messagesPerConversation);
+    run<Conversation<Message, DirectPolicy>>("direct", conversations, messagesPerConversation);
+    return 0;
+}
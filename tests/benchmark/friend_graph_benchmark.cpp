@@ -0,0 +1,77 @@
+#include "../../include/friend_graph.h"
+#include "../../include/user.h"
+#include "allocation_counter.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Friendships as the central CSR graph against the per-user hash maps it
+// replaced (std::unordered_map<User*, bool> in every User)
+int main(int argc, char** argv) {
+    size_t userCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t degree = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 40;
+
+    std::vector<std::unique_ptr<User>> users;
+    users.reserve(userCount);
+    for (size_t i = 0; i < userCount; ++i) {
+        users.push_back(std::make_unique<User>("user" + std::to_string(i) + "@bench.com", "Bench User",
+                                               "pass123", "Male", DateTime(1, 1, 1990)));
+    }
+    std::mt19937 rng(42);
+    std::vector<std::pair<size_t, size_t>> edges;
+    for (size_t i = 0; i < userCount * degree / 2; ++i) {
+        edges.push_back({rng() % userCount, rng() % userCount});
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Friend graph: " << userCount << " users, ~" << degree << " friends each\n";
+
+    // Per-user hash maps, both directions like FriendGraph
+    {
+        size_t before = AllocationCounter::bytes;
+        std::vector<std::unordered_map<User*, bool>> maps(userCount);
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& [a, b] : edges) {
+            if (a != b) {
+                maps[a][users[b].get()] = false;
+                maps[b].emplace(users[a].get(), false);
+            }
+        }
+        double addNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        size_t bytes = AllocationCounter::bytes - before;
+        size_t visited = 0;
+        start = std::chrono::steady_clock::now();
+        for (const auto& map : maps) {
+            for (const auto& entry : map) {
+                visited += entry.second ? 0 : 1;
+            }
+        }
+        double scanNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  hash maps   bytes/friendship " << double(bytes) / visited
+                  << "  add ns " << addNs / edges.size() << "  scan ns/friend " << scanNs / visited << "\n";
+    }
+
+    FriendGraph& graph = FriendGraph::getInstance();
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& [a, b] : edges) {
+        users[a]->addFriend(users[b].get());
+    }
+    graph.compact();
+    double addNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    size_t visited = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& user : users) {
+        graph.forEachFriend(user->getGraphId(), [&visited](FriendGraph::NodeId, bool restricted) {
+            visited += restricted ? 0 : 1;
+        });
+    }
+    double scanNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  CSR graph   bytes/friendship " << double(graph.memoryUsage()) / visited
+              << "  add ns " << addNs / edges.size() << "  scan ns/friend " << scanNs / visited << "\n";
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "../../include/friend_graph.h"
+#include "../../include/user.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+template<typename Function>
+double nsPerCall(int rounds, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        function();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+}
+
+// Friend list retrieval and privacy checks against partitioned rows, next to
+// what User did before: filter every friend into a new vector, and two
+// lookups per post
+int main(int argc, char** argv) {
+    size_t degree = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    size_t postCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 500;
+
+    std::vector<std::unique_ptr<User>> users;
+    for (size_t i = 0; i <= degree; ++i) {
+        users.push_back(std::make_unique<User>("user" + std::to_string(i) + "@bench.com", "Bench User",
+                                               "pass123", "Male", DateTime(1, 1, 1990)));
+    }
+    User& owner = *users[0];
+    std::mt19937 rng(4);
+    for (size_t i = 1; i <= degree; ++i) {
+        owner.addFriend(users[i].get(), rng() % 10 == 0);
+    }
+    FriendGraph& graph = FriendGraph::getInstance();
+    graph.compact();
+    std::vector<std::unique_ptr<Post>> posts;
+    for (size_t i = 0; i < postCount; ++i) {
+        posts.push_back(std::make_unique<Post>(static_cast<int>(i), "Post", Post::Privacy::FriendsOnly, &owner));
+        owner.addPost(posts.back().get());
+    }
+    size_t sink = 0;
+
+    double copyNs = nsPerCall(2000, [&]() {
+        std::vector<User*> result;
+        graph.forEachFriend(owner.getGraphId(), [&](FriendGraph::NodeId id, bool restricted) {
+            if (!restricted) result.push_back(graph.getUser(id));
+        });
+        sink += result.size();
+    });
+    double rangeNs = nsPerCall(2000, [&]() { sink += owner.getFriends(false).size(); });
+    double walkNs = nsPerCall(2000, [&]() {
+        for (User* user : owner.getFriends(false)) sink += user != nullptr;
+    });
+
+    User* viewer = users[degree / 2].get();
+    double twoNs = nsPerCall(200000, [&]() { sink += owner.isFriend(viewer) && !owner.isRestrictedFriend(viewer); });
+    double oneNs = nsPerCall(200000, [&]() { sink += owner.getRelation(viewer) == FriendGraph::Relation::Regular; });
+
+    double feedBeforeNs = nsPerCall(2000, [&]() {
+        std::vector<Post*> visible;
+        for (Post* post : owner.getPosts()) {
+            if (post->getPrivacy() == Post::Privacy::Public || viewer == &owner ||
+                (owner.isFriend(viewer) && !owner.isRestrictedFriend(viewer))) {
+                visible.push_back(post);
+            }
+        }
+        sink += visible.size();
+    });
+    double feedNs = nsPerCall(2000, [&]() { sink += owner.getVisiblePosts(viewer).size(); });
+
+    std::cout << std::fixed << std::setprecision(1) << "Friend lists: " << degree << " friends, " << postCount
+              << " friends-only posts (sink " << sink % 10 << ")\n"
+              << "  getFriends      copy ns " << copyNs << "  range ns " << rangeNs << "  range walk ns " << walkNs
+              << "\n"
+              << "  privacy check   two lookups ns " << twoNs << "  getRelation ns " << oneNs << "\n"
+              << "  getVisiblePosts per-post lookups ns " << feedBeforeNs << "  one lookup ns " << feedNs << "\n";
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "../../include/friend_suggester.h"
+#include "../../include/user.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+template<typename Function>
+double msFor(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The obvious version: nested getFriends calls, a hash map of counts and a
+// full sort per user
+std::vector<User*> nestedSuggestions(const User& user, size_t limit) {
+    std::vector<User*> friends = user.getFriends(false);
+    std::vector<User*> restricted = user.getFriends(true);
+    friends.insert(friends.end(), restricted.begin(), restricted.end());
+    std::unordered_set<const User*> excluded(friends.begin(), friends.end());
+    excluded.insert(&user);
+    std::unordered_map<User*, int> counts;
+    for (User* f : friends) {
+        for (bool flag : {false, true}) {
+            std::vector<User*> theirs = f->getFriends(flag);
+            for (User* w : theirs) {
+                if (!excluded.count(w)) ++counts[w];
+            }
+        }
+    }
+    std::vector<std::pair<int, User*>> ranked;
+    for (const auto& [w, count] : counts) ranked.push_back({-count, w});
+    std::sort(ranked.begin(), ranked.end());
+    std::vector<User*> result;
+    for (size_t i = 0; i < ranked.size() && i < limit; ++i) result.push_back(ranked[i].second);
+    return result;
+}
+
+// Friend-of-friend suggestions on a preferential-attachment graph, where a
+// few hubs have thousands of friends and most users have a handful
+int main(int argc, char** argv) {
+    size_t userCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50000;
+    size_t edgesPerUser = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8;
+    const size_t limit = 10;
+
+    std::vector<std::unique_ptr<User>> users;
+    for (size_t i = 0; i < userCount; ++i) {
+        users.push_back(std::make_unique<User>("user" + std::to_string(i) + "@bench.com", "Bench User",
+                                               "pass123", "Female", DateTime(1, 1, 1990)));
+    }
+    std::mt19937 rng(9);
+    std::vector<size_t> endpoints;  // Each user once per friendship, so picks favour popular users
+    for (size_t i = 1; i < userCount; ++i) {
+        for (size_t e = 0; e < edgesPerUser; ++e) {
+            size_t target = endpoints.empty() || rng() % 5 == 0 ? rng() % i : endpoints[rng() % endpoints.size()];
+            users[i]->addFriend(users[target].get(), rng() % 10 == 0);
+            endpoints.push_back(i);
+            endpoints.push_back(target);
+        }
+    }
+    FriendGraph& graph = FriendGraph::getInstance();
+    graph.compact();
+    size_t maxDegree = 0;
+    for (const auto& user : users) maxDegree = std::max(maxDegree, graph.getFriends(user->getGraphId()).size());
+
+    std::vector<size_t> sample;
+    for (int i = 0; i < 500; ++i) sample.push_back(rng() % userCount);
+    FriendSuggester suggester;
+    size_t sink = 0;
+    double nestedMs = msFor([&]() {
+        for (size_t i : sample) sink += nestedSuggestions(*users[i], limit).size();
+    });
+    double singleMs = msFor([&]() {
+        for (size_t i : sample) sink += suggester.suggestFor(users[i]->getGraphId(), limit).size();
+    });
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    double batchSerialMs = msFor([&]() { sink += suggester.suggestAll(limit, 1).size(); });
+    double batchParallelMs = msFor([&]() { sink += suggester.suggestAll(limit, hardware).size(); });
+
+    std::cout << std::fixed << std::setprecision(1) << "Friend suggestions: " << userCount << " users, "
+              << graph.edgeCount() / 2 << " friendships, max degree " << maxDegree << " (sink " << sink % 10 << ")\n"
+              << "  on demand   nested getFriends us/user " << nestedMs * 1000 / sample.size()
+              << "  FriendSuggester us/user " << singleMs * 1000 / sample.size() << "\n"
+              << "  batch       1 thread ms " << batchSerialMs << "  " << hardware << " threads ms " << batchParallelMs
+              << "  (" << userCount / (batchParallelMs / 1000) << " users/s)\n";
+    return 0;
+}
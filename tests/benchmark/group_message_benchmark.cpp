@@ -0,0 +1,66 @@
+#include "../../include/conversation.h"
+#include "../../include/group_message.h"
+#include "../../include/message.h"
+#include "allocation_counter.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// One post to a large group: a Message copy per receiver, against one
+// GroupMessage with delivery and read bitmaps
+int main(int argc, char** argv) {
+    int members = argc > 1 ? std::atoi(argv[1]) : 500;
+    int posts = argc > 2 ? std::atoi(argv[2]) : 200;
+    const std::string content = "A group announcement long enough to need its own heap allocation";
+
+    std::vector<int> participants;
+    for (int i = 1; i <= members; ++i) {
+        participants.push_back(i);
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Group of " << members << " members, " << posts << " posts\n";
+
+    {
+        Conversation<Message> conv(participants);
+        size_t before = AllocationCounter::bytes;
+        auto start = std::chrono::steady_clock::now();
+        for (int p = 0; p < posts; ++p) {
+            int sender = 1 + p % members;
+            for (int receiver : participants) {
+                if (receiver != sender) {
+                    conv.addMessage(std::make_shared<Message>(sender, receiver, content));
+                }
+            }
+        }
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        for (int userId : participants) {
+            conv.markAllAsRead(userId);
+        }
+        double readUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  Message fan-out  bytes/post " << (AllocationCounter::bytes - before) / posts
+                  << "  us/post " << us / posts << "  markAllAsRead us/member " << readUs / members << "\n";
+    }
+
+    {
+        Conversation<GroupMessage> conv(participants);
+        size_t before = AllocationCounter::bytes;
+        auto start = std::chrono::steady_clock::now();
+        for (int p = 0; p < posts; ++p) {
+            conv.addMessage(std::make_shared<GroupMessage>(1 + p % members, content));
+        }
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        for (int userId : participants) {
+            conv.markAllAsRead(userId);
+        }
+        double readUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  GroupMessage     bytes/post " << (AllocationCounter::bytes - before) / posts
+                  << "  us/post " << us / posts << "  markAllAsRead us/member " << readUs / members << "\n";
+    }
+    return 0;
+}
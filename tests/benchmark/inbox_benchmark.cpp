@@ -0,0 +1,67 @@
+#include "../../include/conversation_store.h"
+#include "../../include/message.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Opening one user's inbox: scanning every conversation they are in and
+// sorting by last message, against a page read from the store's index
+int main(int argc, char** argv) {
+    size_t conversations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const size_t pageSize = 20;
+    const int rounds = 200;
+
+    ConversationStore<Message> store;
+    std::vector<ConversationStore<Message>::ConversationPtr> chats;
+    chats.reserve(conversations);
+    for (size_t i = 0; i < conversations; ++i) {
+        chats.push_back(store.createConversation({1, 2 + static_cast<int>(i)}));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < conversations * 5; ++i) {
+        size_t chat = (i * 7919) % conversations;
+        chats[chat]->addMessage(std::make_shared<Message>(2 + static_cast<int>(chat), 1, "Benchmark message",
+                                                          DateTime::fromTicks(1000000 + i)));
+    }
+    double addNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    // Scan: what opening the inbox costs without the index
+    size_t checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        struct Row {
+            Conversation<Message>* conversation;
+            DateTime lastActivity;
+            size_t unread;
+        };
+        std::vector<Row> rows;
+        for (const auto& chat : chats) {
+            if (chat->isParticipant(1) && !chat->getMessages().empty()) {
+                rows.push_back({chat.get(), chat->getMessages().back()->getTimestamp(), chat->unreadCount(1)});
+            }
+        }
+        std::partial_sort(rows.begin(), rows.begin() + std::min(pageSize, rows.size()), rows.end(),
+                          [](const Row& a, const Row& b) { return b.lastActivity < a.lastActivity; });
+        checksum += rows.front().unread;
+    }
+    double scanUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        checksum += store.getInbox(1, pageSize).front().unread;
+    }
+    double indexUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Inbox for a user in " << conversations << " conversations (page of " << pageSize << ")\n"
+              << "  addMessage ns/msg (with inbox upkeep) " << addNs / (conversations * 5) << "\n"
+              << "  scan + sort   us/open " << scanUs / rounds << "\n"
+              << "  inbox index   us/open " << indexUs / rounds << "\n"
+              << "  (checksum " << checksum << ")\n";
+    return 0;
+}
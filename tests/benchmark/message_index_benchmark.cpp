@@ -0,0 +1,93 @@
+#include "../../include/conversation.h"
+#include "../../include/message.h"
+#include "../../include/message_index.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// A corpus of conversations whose words follow a Zipf-like distribution.
+// "Search my chats" looks in 20 conversations; the scan baseline tokenizes
+// every message in them, the naive baseline scans the whole corpus.
+
+template<typename Func>
+double msFor(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool containsAll(const std::string& content, const std::vector<std::string>& words) {
+    auto tokens = MessageIndex<Message>::tokenize(content);
+    for (const auto& word : words) {
+        if (std::find(tokens.begin(), tokens.end(), word) == tokens.end()) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    size_t conversationCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const size_t perConversation = 100;
+    const size_t vocabulary = 20000;
+
+    std::mt19937 rng(7);
+    std::vector<double> weights;
+    for (size_t w = 1; w <= vocabulary; ++w) weights.push_back(1.0 / w);
+    std::discrete_distribution<size_t> pickWord(weights.begin(), weights.end());
+    std::uniform_int_distribution<int> pickLength(3, 15);
+
+    auto index = std::make_shared<MessageIndex<Message>>();
+    std::vector<std::unique_ptr<Conversation<Message>>> conversations;
+    double buildMs = 0;
+    for (size_t c = 0; c < conversationCount; ++c) {
+        conversations.push_back(std::make_unique<Conversation<Message>>(std::vector<int>{1, 2}));
+        conversations.back()->attachIndex(index);
+        for (size_t m = 0; m < perConversation; ++m) {
+            std::string text;
+            for (int words = pickLength(rng); words > 0; --words) {
+                text += "w" + std::to_string(pickWord(rng)) + (words > 1 ? " " : "");
+            }
+            auto message = std::make_shared<Message>(1 + m % 2, 2 - m % 2, text);
+            buildMs += msFor([&]() { conversations.back()->addMessage(message); });
+        }
+    }
+    size_t total = conversationCount * perConversation;
+
+    std::vector<int> mine;
+    for (size_t c = 0; c < 20; ++c) mine.push_back(conversations[c * (conversationCount / 20)]->getId());
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Message search over " << total << " messages, " << index->postingsSize() / total
+              << " postings bytes/message, indexing " << buildMs * 1e6 / total << " ns/message\n";
+
+    for (const char* query : {"w1", "w50 w3", "w1 w2", "w500"}) {
+        std::vector<std::string> words = MessageIndex<Message>::tokenize(query);
+        size_t scanHits = 0, fullHits = 0, indexHits = 0, allHits = 0;
+        double scanMs = msFor([&]() {
+            for (size_t c = 0; c < 20; ++c) {
+                for (const auto& message : conversations[c * (conversationCount / 20)]->getMessages()) {
+                    scanHits += containsAll(message->getContent(), words);
+                }
+            }
+        });
+        double fullMs = msFor([&]() {
+            for (const auto& conversation : conversations) {
+                for (const auto& message : conversation->getMessages()) {
+                    fullHits += containsAll(message->getContent(), words);
+                }
+            }
+        });
+        double indexMs = msFor([&]() { indexHits = index->search(query, mine).size(); });
+        double allMs = msFor([&]() { allHits = index->search(query).size(); });
+        std::cout << "  \"" << query << "\": my chats scan " << scanMs << " ms / index " << indexMs
+                  << " ms (" << indexHits << (indexHits == scanHits ? "" : " MISMATCH") << " hits)"
+                  << "  corpus scan " << fullMs << " ms / index " << allMs << " ms (" << allHits
+                  << (allHits == fullHits ? "" : " MISMATCH") << " hits)\n";
+    }
+    return 0;
+}
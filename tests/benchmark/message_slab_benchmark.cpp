@@ -0,0 +1,57 @@
+#include "../../include/conversation.h"
+#include "../../include/message.h"
+#include "allocation_counter.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename Build>
+void run(const char* label, size_t count, Build build) {
+    auto conversation = std::make_unique<Conversation<Message>>(std::vector<int>{1, 2});
+
+    size_t allocationsBefore = AllocationCounter::count;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        build(*conversation, i);
+    }
+    double buildMs = msSince(start);
+    size_t allocations = AllocationCounter::count - allocationsBefore;
+
+    start = std::chrono::steady_clock::now();
+    size_t checksum = 0;
+    for (const auto& message : conversation->getMessages()) {
+        checksum += message->getContent().size() + message->getSenderId();
+    }
+    double scanMs = msSince(start);
+
+    start = std::chrono::steady_clock::now();
+    conversation.reset();
+    double freeMs = msSince(start);
+
+    std::cout << "  " << std::setw(11) << label
+              << "  build ns/msg " << buildMs * 1e6 / count
+              << "  allocs/msg " << static_cast<double>(allocations) / count
+              << "  scan ns/msg " << scanMs * 1e6 / count
+              << "  free ms " << freeMs
+              << "  (checksum " << checksum << ")\n";
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Message allocation benchmark (" << count << " messages)\n";
+    run("make_shared", count, [](Conversation<Message>& conversation, size_t i) {
+        conversation.addMessage(std::make_shared<Message>(1 + i % 2, 2 - i % 2, "Short message"));
+    });
+    run("slab", count, [](Conversation<Message>& conversation, size_t i) {
+        conversation.emplaceMessage(1 + static_cast<int>(i % 2), 2 - static_cast<int>(i % 2), "Short message");
+    });
+    return 0;
+}
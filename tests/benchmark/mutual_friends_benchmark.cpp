@@ -0,0 +1,101 @@
+#include "../../include/sorted_intersection.h"
+#include "../../include/user.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+std::vector<uint32_t> randomSet(std::mt19937& rng, size_t size, uint32_t range) {
+    std::unordered_set<uint32_t> seen;
+    while (seen.size() < size) {
+        seen.insert(rng() % range);
+    }
+    std::vector<uint32_t> values(seen.begin(), seen.end());
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+template<typename Function>
+double nsPerCall(int rounds, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        function();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+}
+
+// Mutual friends of two users with the given friend counts among range users
+void kernels(std::mt19937& rng, size_t aSize, size_t bSize, uint32_t range) {
+    auto a = randomSet(rng, aSize, range);
+    auto b = randomSet(rng, bSize, range);
+    int rounds = static_cast<int>(std::max<size_t>(20, 20000000 / (aSize + bSize)));
+    size_t sink = 0;
+
+    // What operator& did before: walk one friend set, probe the other's hash set
+    std::unordered_set<uint32_t> bHash(b.begin(), b.end());
+    double hashNs = nsPerCall(rounds, [&]() {
+        std::vector<uint32_t> result;
+        for (uint32_t value : a) {
+            if (bHash.count(value)) result.push_back(value);
+        }
+        sink += result.size();
+    });
+    double scalarNs = nsPerCall(rounds, [&]() {
+        std::vector<uint32_t> result;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+        sink += result.size();
+    });
+    double listNs = nsPerCall(rounds, [&]() {
+        std::vector<uint32_t> result;
+        SortedIntersection::forEach(a.data(), a.size(), b.data(), b.size(),
+                                    [&result](uint32_t value) { result.push_back(value); });
+        sink += result.size();
+    });
+    double countNs = nsPerCall(rounds, [&]() { sink += SortedIntersection::count(a.data(), a.size(), b.data(), b.size()); });
+
+    std::cout << "  " << std::setw(6) << a.size() << " x " << std::setw(7) << b.size()
+              << "  hash probe " << std::setw(9) << hashNs / 1000
+              << "  std::set_intersection " << std::setw(9) << scalarNs / 1000
+              << "  SortedIntersection " << std::setw(9) << listNs / 1000
+              << "  count only " << std::setw(9) << countNs / 1000 << "  (us, sink " << sink % 10 << ")\n";
+}
+
+int main(int argc, char** argv) {
+    size_t degree = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000;
+    std::mt19937 rng(5);
+
+    std::cout << std::fixed << std::setprecision(2) << "Sorted-set intersection kernels\n";
+    kernels(rng, degree, degree, static_cast<uint32_t>(degree * 4));       // Dense overlap
+    kernels(rng, degree, degree, static_cast<uint32_t>(degree * 100));     // Sparse overlap
+    kernels(rng, degree * 10, degree * 10, static_cast<uint32_t>(degree * 40));
+    kernels(rng, 100, degree * 10, static_cast<uint32_t>(degree * 20));    // Skewed: gallops
+    kernels(rng, degree / 10, degree, static_cast<uint32_t>(degree * 4));  // Below the gallop ratio
+
+    // Through User: two users with `degree` friends each in a graph of 3x as many users
+    std::vector<std::unique_ptr<User>> users;
+    for (size_t i = 0; i < degree * 3; ++i) {
+        users.push_back(std::make_unique<User>("user" + std::to_string(i) + "@bench.com", "Bench User",
+                                               "pass123", "Female", DateTime(1, 1, 1990)));
+    }
+    User& first = *users[0];
+    User& second = *users[1];
+    for (uint32_t id : randomSet(rng, degree, static_cast<uint32_t>(users.size() - 2))) {
+        first.addFriend(users[id + 2].get());
+    }
+    for (uint32_t id : randomSet(rng, degree, static_cast<uint32_t>(users.size() - 2))) {
+        second.addFriend(users[id + 2].get());
+    }
+    FriendGraph::getInstance().compact();
+    size_t mutual = 0;
+    double listNs = nsPerCall(2000, [&]() { mutual = (first & second).size(); });
+    double countNs = nsPerCall(2000, [&]() { mutual = first.countMutualFriends(second); });
+    std::cout << "User " << degree << " x " << degree << " friends, " << mutual << " mutual\n"
+              << "  operator& us " << listNs / 1000 << "  countMutualFriends us " << countNs / 1000 << "\n";
+    return 0;
+}
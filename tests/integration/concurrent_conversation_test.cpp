@@ -0,0 +1,150 @@
+#include "../../include/concurrent_conversation.h"
+#include "../../include/message.h"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+void testConcurrentAppends() {
+    std::cout << "Testing Concurrent Appends..." << std::endl;
+    
+    // Test 1: Many producers and a reader running at the same time
+    const int producers = 8;
+    const int perProducer = 20000;
+    std::vector<int> participants;
+    for (int id = 1; id <= producers + 1; ++id) participants.push_back(id);
+    ConcurrentConversation<Message> conv(participants);
+    
+    std::atomic<bool> done(false);
+    std::atomic<int> badSnapshots(0);
+    std::thread reader([&]() {
+        std::size_t lastSize = 0;
+        while (!done.load()) {
+            auto snapshot = conv.snapshot();
+            if (snapshot.size() < lastSize) ++badSnapshots;
+            for (std::size_t i = lastSize; i < snapshot.size(); ++i) {
+                if (!snapshot[i] || snapshot[i]->getSequence() != i + 1) ++badSnapshots;
+            }
+            lastSize = snapshot.size();
+        }
+    });
+    
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&conv, p]() {
+            for (int i = 0; i < perProducer; ++i) {
+                conv.addMessage(std::make_shared<Message>(p + 1, producers + 1, std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    done.store(true);
+    reader.join();
+    
+    assert(badSnapshots.load() == 0 && "Test 1.1 failed: Reader saw an incomplete or shrinking snapshot");
+    auto snapshot = conv.snapshot();
+    assert(snapshot.size() == static_cast<std::size_t>(producers * perProducer) && "Test 1.2 failed: Messages lost");
+    std::cout << "Test 1 passed: Concurrent appends with a live reader" << std::endl;
+    
+    // Test 2: Each producer's messages keep their send order
+    std::vector<int> nextExpected(producers + 1, 0);
+    for (std::size_t i = 0; i < snapshot.size(); ++i) {
+        int sender = snapshot[i]->getSenderId();
+        assert(snapshot[i]->getContent() == std::to_string(nextExpected[sender]) && "Test 2.1 failed: Producer order broken");
+        ++nextExpected[sender];
+    }
+    std::cout << "Test 2 passed: Per-producer order" << std::endl;
+}
+
+void testConcurrentValidation() {
+    std::cout << "\nTesting Concurrent Conversation Validation..." << std::endl;
+    
+    // Test 3: Participants and capacity are enforced
+    ConcurrentConversation<Message> conv({1, 2}, 4);
+    try {
+        conv.addMessage(std::make_shared<Message>(1, 3, "Outsider"));
+        assert(false && "Test 3.1 failed: Should reject non-participant");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "ValidationError" && "Test 3.2 failed: Wrong exception type");
+    }
+    for (std::size_t i = 0; i < conv.capacity(); ++i) {
+        conv.addMessage(std::make_shared<Message>(1, 2, "Fill"));
+    }
+    try {
+        conv.addMessage(std::make_shared<Message>(1, 2, "Overflow"));
+        assert(false && "Test 3.3 failed: Should reject messages past capacity");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "CapacityError" && "Test 3.4 failed: Wrong exception type");
+    }
+    assert(conv.size() == conv.capacity() && "Test 3.5 failed: Size mismatch after overflow");
+    std::cout << "Test 3 passed: Validation" << std::endl;
+}
+
+// Fails after its slot is claimed, like a producer whose segment could not
+// be allocated
+class FlakyMessage : public Message {
+public:
+    using Message::Message;
+    void setSequence(uint64_t value) {
+        if (getContent() == "fail") {
+            throw std::runtime_error("Injected failure");
+        }
+        Message::setSequence(value);
+    }
+};
+
+void testFailedProducers() {
+    std::cout << "\nTesting Failed Producers..." << std::endl;
+    
+    // Test 4: A producer that fails after claiming a slot does not stall the
+    // messages after it; its slot reads as null
+    const int producers = 4;
+    const int perProducer = 3000;
+    ConcurrentConversation<FlakyMessage> conv({1, 2});
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&conv, &failures]() {
+            for (int i = 0; i < perProducer; ++i) {
+                try {
+                    conv.addMessage(std::make_shared<FlakyMessage>(1, 2, i % 7 == 3 ? "fail" : "ok"));
+                } catch (const std::runtime_error&) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    
+    auto snapshot = conv.snapshot();
+    assert(snapshot.size() == static_cast<std::size_t>(producers * perProducer) &&
+           "Test 4.1 failed: Failed slots should not stall publication");
+    int skipped = 0;
+    for (std::size_t i = 0; i < snapshot.size(); ++i) {
+        if (!snapshot[i]) {
+            ++skipped;
+        } else {
+            assert(snapshot[i]->getSequence() == i + 1 && "Test 4.2 failed: Sequence mismatch");
+        }
+    }
+    assert(skipped == failures.load() && failures.load() > 0 && "Test 4.3 failed: Skipped slot count mismatch");
+    conv.addMessage(std::make_shared<FlakyMessage>(1, 2, "after"));
+    assert(conv.size() == snapshot.size() + 1 && "Test 4.4 failed: Appends after a failure");
+    std::cout << "Test 4 passed: Failed producers" << std::endl;
+}
+
+int main() {
+    try {
+        testConcurrentAppends();
+        testConcurrentValidation();
+        testFailedProducers();
+        std::cout << "\nAll concurrent conversation tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
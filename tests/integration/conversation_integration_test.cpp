@@ -1,7 +1,10 @@
 #include "../../include/conversation.h"
 #include "../../include/message.h"
 #include <cassert>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <thread>
 #include <chrono>
@@ -35,7 +38,7 @@ void testMessageTimestamps() {
     Conversation<Message> conv(participants);
     
     auto msg1 = std::make_shared<Message>(1, 2, "First message");
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
     auto msg2 = std::make_shared<Message>(2, 1, "Second message");
     
     conv.addMessage(msg1);
@@ -46,6 +49,209 @@ void testMessageTimestamps() {
     std::cout << "Test 2 passed: Message timestamps are correct" << std::endl;
 }
 
+void testBurstOrdering() {
+    std::cout << "\nTesting Burst Message Ordering..." << std::endl;
+    
+    // Test 6: Messages sent back-to-back keep their order without sleeping
+    std::vector<int> participants = {1, 2};
+    Conversation<Message> conv(participants);
+    std::vector<std::shared_ptr<Message>> sent;
+    for (int i = 0; i < 1000; ++i) {
+        sent.push_back(std::make_shared<Message>(1 + i % 2, 2 - i % 2, "Burst " + std::to_string(i)));
+        conv.addMessage(sent.back());
+    }
+    
+    const auto& messages = conv.getMessages();
+    assert(messages.size() == sent.size() && "Test 6.1 failed: Message count mismatch");
+    for (size_t i = 0; i < sent.size(); ++i) {
+        assert(messages[i] == sent[i] && "Test 6.2 failed: Burst order not preserved");
+        assert(messages[i]->getSequence() == i + 1 && "Test 6.3 failed: Sequence mismatch");
+    }
+    for (size_t i = 1; i < messages.size(); ++i) {
+        assert(*messages[i - 1] < *messages[i] && "Test 6.4 failed: Ordering is not total");
+    }
+    std::cout << "Test 6 passed: Burst messages are totally ordered" << std::endl;
+}
+
+void testEmplacedMessages() {
+    std::cout << "\nTesting Emplaced Messages..." << std::endl;
+    
+    // Test 7: Messages built inside the conversation
+    std::weak_ptr<Message> kept;
+    {
+        std::vector<int> participants = {1, 2};
+        Conversation<Message> conv(participants);
+        for (int i = 0; i < 3000; ++i) {
+            conv.emplaceMessage(1 + i % 2, 2 - i % 2, "Slab message " + std::to_string(i));
+        }
+        assert(conv.getMessages().size() == 3000 && "Test 7.1 failed: Message count mismatch");
+        assert(conv.getMessages()[2999]->getContent() == "Slab message 2999" && "Test 7.2 failed: Content mismatch");
+        assert(conv.getMessagesByUser(1).size() == 1500 && "Test 7.3 failed: Sender index mismatch");
+        
+        try {
+            conv.emplaceMessage(1, 3, "Not a participant");
+            assert(false && "Test 7.4 failed: Should reject non-participant");
+        } catch (const FacebookException& e) {
+            assert(e.getType() == "ValidationError" && "Test 7.5 failed: Wrong exception type");
+        }
+        assert(conv.getMessages().size() == 3000 && "Test 7.6 failed: Rejected message was kept");
+        kept = conv.getMessages()[0];
+    }
+    assert(kept.expired() && "Test 7.7 failed: Slab should be released with the conversation");
+    std::cout << "Test 7 passed: Emplaced messages" << std::endl;
+}
+
+void testMessageSearch() {
+    std::cout << "\nTesting Message Search..." << std::endl;
+    
+    // Test 8: One index shared by several conversations
+    auto index = std::make_shared<MessageIndex<Message>>();
+    Conversation<Message> alice({1, 2});
+    Conversation<Message> bob({2, 3});
+    alice.addMessage(std::make_shared<Message>(1, 2, "Are we still on for the game tonight?"));
+    alice.attachIndex(index);
+    bob.attachIndex(index);
+    auto reply = std::make_shared<Message>(2, 1, "Yes, the game starts at eight");
+    alice.addMessage(reply);
+    bob.addMessages({std::make_shared<Message>(3, 2, "Did you watch the game?")});
+    
+    assert(index->size() == 3 && "Test 8.1 failed: Existing and new messages should be indexed");
+    assert(index->search("game").size() == 3 && "Test 8.2 failed: Unscoped search");
+    auto results = index->search("game", {alice.getId()});
+    assert(results.size() == 2 && results[1] == reply && "Test 8.3 failed: Search scoped to one conversation");
+    results = index->searchPhrase("the game starts", {alice.getId(), bob.getId()});
+    assert(results.size() == 1 && results[0] == reply && "Test 8.4 failed: Phrase search");
+    std::cout << "Test 8 passed: Message search" << std::endl;
+}
+
+void testColdHistory() {
+    std::cout << "\nTesting Cold History..." << std::endl;
+    
+    // Test 9: Read history beyond the resident window moves to segments
+    Conversation<Message> conv({1, 2});
+    std::vector<std::shared_ptr<Message>> sent;
+    for (int i = 0; i < 500; ++i) {
+        sent.push_back(std::make_shared<Message>(1 + i % 2, 2 - i % 2, "History " + std::to_string(i),
+                                                 DateTime(1, 3, 2024, 9, i / 60, i % 60)));
+        conv.addMessage(sent.back());
+    }
+    conv.markReadUpTo(2, DateTime(1, 3, 2024, 9, 5, 0));  // First unread is message 302
+    conv.markAllAsRead(1);
+    std::weak_ptr<Message> oldest = sent[0];
+    std::weak_ptr<Message> unreadOld = sent[400];
+    sent.clear();
+    
+    conv.enableColdTier(100, 64);
+    assert(conv.getColdMessageCount() == 302 && conv.getMessages().size() == 198 &&
+           "Test 9.1 failed: Spill should stop at the oldest unread message");
+    assert(oldest.expired() && !unreadOld.expired() && "Test 9.2 failed: Spilled messages should be released");
+    assert(conv.unreadCount(2) == 99 && conv.getUnreadMessages(2).size() == 99 && "Test 9.3 failed: Read tracking after spill");
+    assert(conv.getMessagesByUser(1).size() == 99 && "Test 9.4 failed: Sender index after spill");
+    std::cout << "Test 9 passed: Spill to cold segments" << std::endl;
+    
+    // Test 10: Paginated reads page history back in
+    const Conversation<Message>& residentOnly = conv;
+    assert(residentOnly.getMessagesBefore(std::size_t(10), 20).size() == 10 && "Test 10.1 failed: Const reads stay resident");
+    auto page = conv.getMessagesBefore(std::size_t(10), 20);
+    assert(page.size() == 20 && page[0]->getContent() == "History 292" && page[19]->getContent() == "History 311" &&
+           "Test 10.2 failed: Page should continue into cold history");
+    assert(page[0]->isRead() && page[0]->getTimestamp() == DateTime(1, 3, 2024, 9, 4, 52) &&
+           "Test 10.3 failed: Paged-in message fields");
+    auto window = conv.getMessagesBetween(DateTime(1, 3, 2024, 9, 0, 0), DateTime(1, 3, 2024, 9, 0, 5));
+    assert(window.size() == 5 && window[0]->getContent() == "History 0" && "Test 10.4 failed: Window over cold history");
+    assert(conv.getMessages().size() == 500 && "Test 10.5 failed: Whole history paged in");
+    for (size_t i = 0; i < conv.getMessages().size(); ++i) {
+        assert(conv.getMessages()[i]->getSequence() == i + 1 && "Test 10.6 failed: Paged-in order");
+    }
+    assert(conv.getMessagesByUser(1).size() == 250 && conv.getMessagesByUser(2).size() == 250 &&
+           "Test 10.7 failed: Paged-in messages should be in the sender index");
+    assert(conv.unreadCount(2) == 99 && conv.getUnreadMessages(2).size() == 99 && conv.unreadCount(1) == 0 &&
+           "Test 10.8 failed: Paged-in messages should count as read");
+    conv.markAsRead(conv.getMessages()[0]);
+    assert(conv.unreadCount(1) == 0 && conv.unreadCount(2) == 99 && "Test 10.9 failed: Reading paged-in history");
+    std::cout << "Test 10 passed: Page cold history back in" << std::endl;
+    
+    // Test 11: The next add evicts paged-in history without rewriting it
+    size_t segments = conv.getColdSegmentCount();
+    conv.addMessage(std::make_shared<Message>(1, 2, "Newest", DateTime(1, 3, 2024, 10, 0, 0)));
+    assert(conv.getMessages().size() == 199 && conv.getColdSegmentCount() == segments &&
+           "Test 11.1 failed: Paged-in history should be evicted");
+    assert(conv.getLatestMessages(1)[0]->getContent() == "Newest" && "Test 11.2 failed: Newest message");
+    assert(conv.getMessagesByUser(1).size() == 100 && conv.getMessagesByUser(2).size() == 99 &&
+           conv.unreadCount(2) == 100 && conv.getUnreadMessages(2).size() == 100 &&
+           "Test 11.3 failed: Indexes after eviction");
+    std::cout << "Test 11 passed: Evict paged-in history" << std::endl;
+    
+    // Test 12: Reads reaching past several segments page through all of them
+    auto spilled = []() {
+        auto history = std::make_unique<Conversation<Message>>(std::vector<int>{1, 2});
+        history->enableColdTier(10, 10);
+        for (int i = 0; i < 40; ++i) {
+            auto message = std::make_shared<Message>(1, 2, "Minute " + std::to_string(i), DateTime(2, 3, 2024, 10, i, 0));
+            message->markAsRead();
+            history->addMessage(message);
+        }
+        return history;
+    };
+    auto history = spilled();
+    assert(history->getColdSegmentCount() == 3 && history->getMessages().size() == 10 &&
+           "Test 12.1 failed: History should spill into three segments");
+    auto between = history->getMessagesBetween(DateTime(2, 3, 2024, 10, 2, 0), DateTime(2, 3, 2024, 10, 6, 0));
+    assert(between.size() == 4 && between[0]->getContent() == "Minute 2" && between[3]->getContent() == "Minute 5" &&
+           "Test 12.2 failed: Window in the oldest segment");
+    history = spilled();
+    auto before = history->getMessagesBefore(DateTime(2, 3, 2024, 10, 5, 0), 3);
+    assert(before.size() == 3 && before[0]->getContent() == "Minute 2" && before[2]->getContent() == "Minute 4" &&
+           "Test 12.3 failed: Page before a time in the oldest segment");
+    history = spilled();
+    assert(history->getMessagesBetween(DateTime(2, 3, 2024, 10, 25, 0), DateTime(2, 3, 2024, 10, 32, 0)).size() == 7 &&
+           history->getMessages().size() == 20 && "Test 12.4 failed: Paging should stop at the window");
+    std::cout << "Test 12 passed: Page through several segments" << std::endl;
+    
+    // Test 13: A spill that cannot be written keeps history resident
+    Conversation<Message> blocked({1, 2});
+    blocked.enableColdTier(1, 1, 0, "/dev/null/segments");
+    for (int i = 0; i < 3; ++i) {
+        auto message = std::make_shared<Message>(1, 2, "Blocked " + std::to_string(i), DateTime(3, 3, 2024, 10, i, 0));
+        message->markAsRead();
+        blocked.addMessage(message);
+    }
+    assert(blocked.getMessages().size() == 3 && blocked.getColdSegmentCount() == 0 &&
+           "Test 13.1 failed: Failed spills should keep every message once");
+    try {
+        blocked.spillColdHistory();
+        assert(false && "Test 13.2 failed: Explicit spill should report the failure");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "FileError" && "Test 13.3 failed: Wrong exception type");
+    }
+    assert(blocked.getColdTierError().find("FileError") != std::string::npos &&
+           "Test 13.4 failed: Failed spill after an add should be recorded");
+    
+    // Failures back off: attempts come after 1, 2, 4, ... more adds
+    std::filesystem::create_directories("data");
+    std::ofstream("data/blocked") << "not a directory";
+    Conversation<Message> retried({1, 2});
+    retried.enableColdTier(1, 1, 0, "data/blocked/segments");
+    auto addRead = [&retried](int i) {
+        auto message = std::make_shared<Message>(1, 2, "Retry " + std::to_string(i), DateTime(4, 3, 2024, 10, i, 0));
+        message->markAsRead();
+        retried.addMessage(message);
+    };
+    for (int i = 0; i < 5; ++i) {
+        addRead(i);  // Attempts at 2, 3 and 5 messages fail; the next is due at 9
+    }
+    assert(!retried.getColdTierError().empty() && "Test 13.5 failed: Blocked directory should fail");
+    std::filesystem::remove("data/blocked");
+    for (int i = 5; i < 8; ++i) {
+        addRead(i);
+    }
+    assert(retried.getColdSegmentCount() == 0 && "Test 13.6 failed: Spill should wait for the backoff");
+    addRead(8);
+    assert(retried.getColdSegmentCount() == 1 && retried.getColdMessageCount() == 8 &&
+           retried.getColdTierError().empty() && "Test 13.7 failed: Spill should resume after the backoff");
+    std::cout << "Test 13 passed: Failed spills" << std::endl;
+}
+
 void testMessageReadStatus() {
     std::cout << "\nTesting Message Read Status..." << std::endl;
     
@@ -64,7 +270,7 @@ void testMessageReadStatus() {
     auto unreadBefore = conv.getUnreadMessages(2);
     assert(unreadBefore.size() == 2 && "Test 3.1 failed: Initial unread count wrong");
     
-    msg1->markAsRead();
+    conv.markAsRead(msg1);
     auto unreadAfter = conv.getUnreadMessages(2);
     assert(unreadAfter.size() == 1 && "Test 3.2 failed: Unread count after marking as read");
     std::cout << "Test 3 passed: Message read status tracking works" << std::endl;
@@ -130,6 +336,10 @@ int main() {
     try {
         testConversationWithRealMessages();
         testMessageTimestamps();
+        testBurstOrdering();
+        testEmplacedMessages();
+        testMessageSearch();
+        testColdHistory();
         testMessageReadStatus();
         testParticipantInteractions();
         testMessageFiltering();
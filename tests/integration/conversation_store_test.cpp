@@ -0,0 +1,131 @@
+#include "../../include/conversation_store.h"
+#include "../../include/message.h"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+void testInboxFollowsMessages() {
+    std::cout << "Testing Inbox Updates From Messages..." << std::endl;
+
+    // Test 1: New conversations are listed for every participant
+    ConversationStore<Message> store;
+    auto work = store.createConversation({1, 2, 3});
+    auto family = store.createConversation({1, 4});
+    auto other = store.createConversation({2, 3});
+    assert(store.size() == 3 && "Test 1.1 failed: Store size mismatch");
+    assert(store.getInbox(1, 10).size() == 2 && store.getInbox(3, 10).size() == 2 &&
+           "Test 1.2 failed: Each participant should see their conversations");
+    assert(store.getConversation(work->getId()) == work && !store.getConversation(-1) &&
+           "Test 1.3 failed: Lookup by ID");
+
+    // Test 2: The conversation with the newest message comes first
+    work->addMessage(std::make_shared<Message>(2, 1, "Standup?", DateTime(1, 3, 2024, 9, 0)));
+    family->addMessage(std::make_shared<Message>(4, 1, "Dinner at 7", DateTime(1, 3, 2024, 10, 0)));
+    other->addMessage(std::make_shared<Message>(2, 3, "Lunch?", DateTime(1, 3, 2024, 11, 0)));
+    auto inbox = store.getInbox(1, 10);
+    assert(inbox[0].conversation == family && inbox[1].conversation == work &&
+           "Test 2.1 failed: Inbox should be ordered by last message");
+    assert(inbox[0].lastActivity == DateTime(1, 3, 2024, 10, 0) && "Test 2.2 failed: Last activity mismatch");
+    work->addMessage(std::make_shared<Message>(3, 1, "In 5", DateTime(1, 3, 2024, 12, 0)));
+    inbox = store.getInbox(1, 10);
+    assert(inbox[0].conversation == work && "Test 2.3 failed: New message should move conversation up");
+    assert(store.getInbox(2, 1)[0].conversation == work && "Test 2.4 failed: Sender's inbox should update too");
+
+    // Test 3: Unread counts follow messages and reads
+    assert(inbox[0].unread == 2 && inbox[1].unread == 1 && store.getTotalUnread(1) == 3 &&
+           "Test 3.1 failed: Unread counts mismatch");
+    work->markAsRead(work->getMessages()[0]);
+    assert(store.getInbox(1, 1)[0].unread == 1 && store.getTotalUnread(1) == 2 &&
+           "Test 3.2 failed: markAsRead should update the inbox");
+    work->markAllAsRead(1);
+    family->markReadUpTo(1, DateTime(1, 3, 2024, 10, 0));
+    assert(store.getTotalUnread(1) == 0 && "Test 3.3 failed: Reads should clear unread counts");
+    assert(store.getTotalUnread(3) == 1 && "Test 3.4 failed: Other users' counts should be untouched");
+    std::cout << "Test 1-3 passed: Inbox follows messages" << std::endl;
+}
+
+void testInboxFollowsMembership() {
+    std::cout << "\nTesting Inbox Updates From Membership..." << std::endl;
+
+    // Test 4: Bulk adds and existing conversations are reflected
+    ConversationStore<Message> store;
+    auto existing = std::make_shared<Conversation<Message>>(std::vector<int>{5, 6});
+    existing->addMessage(std::make_shared<Message>(5, 6, "Before the store", DateTime(2, 3, 2024, 8, 0)));
+    store.addConversation(existing);
+    assert(store.getTotalUnread(6) == 1 && store.getInbox(6, 1)[0].lastActivity == DateTime(2, 3, 2024, 8, 0) &&
+           "Test 4.1 failed: Added conversation should be listed with its state");
+    auto group = store.createConversation({5, 6, 7});
+    std::vector<std::shared_ptr<Message>> batch;
+    for (int i = 0; i < 10; ++i) {
+        batch.push_back(std::make_shared<Message>(5 + i % 3, 5 + (i + 1) % 3, "Batch", DateTime(2, 3, 2024, 9, i)));
+    }
+    assert(group->addMessages(batch).empty() && "Test 4.2 failed: Batch should be accepted");
+    assert(store.getInbox(6, 1)[0].conversation == group && store.getInbox(6, 1)[0].lastActivity == DateTime(2, 3, 2024, 9, 9) &&
+           "Test 4.3 failed: Batch should move conversation up");
+    assert(store.getTotalUnread(6) == 1 + group->unreadCount(6) && "Test 4.4 failed: Batch unread mismatch");
+    existing->addMessage(std::make_shared<Message>(6, 5, "Late reply", DateTime(2, 3, 2024, 7, 0)));
+    assert(store.getInbox(5, 10)[1].conversation == existing &&
+           store.getInbox(5, 10)[1].lastActivity == DateTime(2, 3, 2024, 8, 0) &&
+           "Test 4.5 failed: A late message should not change last activity");
+    assert(store.getTotalUnread(5) == group->unreadCount(5) + 1 && store.getTotalUnread(6) == 1 + group->unreadCount(6) &&
+           "Test 4.6 failed: Only the receiver's unread count should change");
+
+    bool threw = false;
+    try {
+        store.addConversation(existing);
+    } catch (const FacebookException&) {
+        threw = true;
+    }
+    assert(threw && "Test 4.7 failed: Adding a conversation twice should throw");
+
+    // Test 5: Joining and leaving a conversation updates the inbox
+    group->addParticipant(8);
+    assert(store.getInbox(8, 10).size() == 1 && store.getInbox(8, 1)[0].lastActivity == DateTime(2, 3, 2024, 9, 9) &&
+           "Test 5.1 failed: New participant should see the conversation");
+    group->removeParticipant(6);
+    assert(store.getInbox(6, 10).size() == 1 && store.getInbox(6, 1)[0].conversation == existing &&
+           store.getTotalUnread(6) == 1 && "Test 5.2 failed: Leaving should drop the conversation");
+    std::cout << "Test 4-5 passed: Inbox follows membership" << std::endl;
+}
+
+void testLargeInboxPaging() {
+    std::cout << "\nTesting Large Inbox Paging..." << std::endl;
+
+    // Test 6: A user in many conversations pages through them newest first
+    ConversationStore<Message> store;
+    std::vector<ConversationStore<Message>::ConversationPtr> chats;
+    for (int i = 0; i < 500; ++i) {
+        chats.push_back(store.createConversation({1, 100 + i}));
+    }
+    for (int i = 0; i < 500; ++i) {
+        int chat = (i * 7) % 500;
+        chats[chat]->addMessage(std::make_shared<Message>(100 + chat, 1, "Hi", DateTime(3, 3, 2024, 0, 0, 0, i)));
+    }
+    auto page = store.getInbox(1, 50);
+    size_t seen = 0;
+    DateTime previous = DateTime(31, 12, 2100);
+    while (!page.empty()) {
+        for (const auto& item : page) {
+            assert(!(previous < item.lastActivity) && "Test 6.1 failed: Pages should be newest first");
+            previous = item.lastActivity;
+            ++seen;
+        }
+        page = store.getInboxAfter(1, page.back(), 50);
+    }
+    assert(seen == 500 && store.getTotalUnread(1) == 500 && "Test 6.2 failed: Paging should cover every chat");
+    std::cout << "Test 6 passed: Large inbox paging" << std::endl;
+}
+
+int main() {
+    try {
+        testInboxFollowsMessages();
+        testInboxFollowsMembership();
+        testLargeInboxPaging();
+        std::cout << "\nAll ConversationStore integration tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -22,9 +22,9 @@ void testMessageSorting() {
     // Test 2: Sort messages by timestamp
     std::vector<Message> messages;
     messages.push_back(Message(1, 2, "First message"));
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
     messages.push_back(Message(1, 2, "Second message"));
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
     messages.push_back(Message(1, 2, "Third message"));
     
     // Sort messages
@@ -52,11 +52,11 @@ void testMessageOrdering() {
     auto msg1 = std::make_shared<Message>(1, 2, "First message");
     std::cout << "Message 1 sent at: " << getCurrentTimeString() << std::endl;
     
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
     auto msg2 = std::make_shared<Message>(2, 1, "Second message");
     std::cout << "Message 2 sent at: " << getCurrentTimeString() << std::endl;
     
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
     auto msg3 = std::make_shared<Message>(1, 2, "Third message");
     std::cout << "Message 3 sent at: " << getCurrentTimeString() << std::endl;
     
@@ -133,8 +133,8 @@ void testComplexScenario() {
     assert(conv.getUnreadMessages(3).size() == 1 && "Test 4.7 failed: User 3 unread count wrong");
     
     // Mark some messages as read
-    msg2->markAsRead();
-    msg3->markAsRead();
+    conv.markAsRead(msg2);
+    conv.markAsRead(msg3);
     
     assert(conv.getUnreadMessages(1).size() == 0 && "Test 4.8 failed: User 1 unread count after marking as read");
     
@@ -0,0 +1,72 @@
+#include "../../include/clock.h"
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+void testClockNow() {
+    std::cout << "Testing Clock Now..." << std::endl;
+    
+    // Test 1: Timestamps are valid local times
+    DateTime dt1 = Clock::getInstance().now();
+    assert(dt1.isValid() && "Test 1.1 failed: Clock should return a valid DateTime");
+    assert(dt1.getYear() >= 2024 && "Test 1.2 failed: Clock year looks wrong");
+    
+    std::time_t time = std::time(nullptr);
+    std::tm ltm{};
+#ifdef _WIN32
+    localtime_s(&ltm, &time);
+#else
+    localtime_r(&time, &ltm);
+#endif
+    assert(dt1.getYear() == 1900 + ltm.tm_year && "Test 1.3 failed: Year does not match localtime");
+    std::cout << "Test 1 passed: Clock returns current local time" << std::endl;
+    
+    // Test 2: Sub-second precision and ordering
+    DateTime previous = Clock::getInstance().now();
+    bool sawSubSecond = previous.getMicrosecond() != 0;
+    for (int i = 0; i < 10000; ++i) {
+        DateTime current = Clock::getInstance().now();
+        assert(!(current < previous) && "Test 2.1 failed: Clock went backwards");
+        sawSubSecond = sawSubSecond || current.getMicrosecond() != 0;
+        previous = current;
+    }
+    assert(sawSubSecond && "Test 2.2 failed: Clock should carry microseconds");
+    std::cout << "Test 2 passed: Clock precision and ordering" << std::endl;
+}
+
+void testClockConcurrency() {
+    std::cout << "\nTesting Clock Concurrency..." << std::endl;
+    
+    // Test 3: Many threads reading the clock concurrently
+    std::vector<std::thread> threads;
+    std::vector<int> invalid(8, 0);
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([t, &invalid]() {
+            for (int i = 0; i < 100000; ++i) {
+                if (!Clock::getInstance().now().isValid()) {
+                    ++invalid[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int count : invalid) {
+        assert(count == 0 && "Test 3.1 failed: Concurrent reads returned invalid timestamps");
+    }
+    std::cout << "Test 3 passed: Concurrent clock reads" << std::endl;
+}
+
+int main() {
+    try {
+        testClockNow();
+        testClockConcurrency();
+        std::cout << "\nAll Clock unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,167 @@
+#include "../../include/columnar_message_store.h"
+#include "../../include/conversation.h"
+#include "../../include/message.h"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Reference answer computed one message at a time
+template<typename Predicate>
+std::vector<std::size_t> expectedPositions(const ColumnarMessageStore& store, Predicate predicate) {
+    std::vector<std::size_t> result;
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        if (predicate(i)) result.push_back(i);
+    }
+    return result;
+}
+
+ColumnarMessageStore buildStore(std::size_t count) {
+    ColumnarMessageStore store;
+    for (std::size_t i = 0; i < count; ++i) {
+        Message message(1 + static_cast<int>(i % 5), 1 + static_cast<int>((i * 7) % 5), "Message");
+        if (i % 3 == 0) message.markAsRead();
+        store.append(message);
+    }
+    return store;
+}
+
+void testColumnarFilters() {
+    std::cout << "Testing Columnar Filters (" << ColumnarMessageStore::simdLevel() << ")..." << std::endl;
+    
+    // Test 1: ID filters match a scalar scan, including the tail past the last full block
+    ColumnarMessageStore store = buildStore(1003);
+    assert(store.size() == 1003 && "Test 1.1 failed: Size mismatch");
+    auto senders = ColumnarMessageStore::positions(store.matchSender(3));
+    assert(senders == expectedPositions(store, [&](std::size_t i) { return store.getSenderId(i) == 3; }) &&
+           "Test 1.2 failed: Sender filter mismatch");
+    auto unread = store.matchUnread(2);
+    assert(ColumnarMessageStore::positions(unread) ==
+           expectedPositions(store, [&](std::size_t i) { return store.getReceiverId(i) == 2 && !store.isRead(i); }) &&
+           "Test 1.3 failed: Unread filter mismatch");
+    std::cout << "Test 1 passed: ID filters" << std::endl;
+    
+    // Test 2: Read updates and bitmap intersection
+    std::size_t before = ColumnarMessageStore::countMatches(unread);
+    store.markAsRead(ColumnarMessageStore::positions(unread)[0]);
+    assert(ColumnarMessageStore::countMatches(store.matchUnread(2)) == before - 1 && "Test 2.1 failed: markAsRead not reflected");
+    auto both = store.matchSender(1);
+    ColumnarMessageStore::intersect(both, store.matchReceiver(3));
+    assert(ColumnarMessageStore::positions(both) ==
+           expectedPositions(store, [&](std::size_t i) { return store.getSenderId(i) == 1 && store.getReceiverId(i) == 3; }) &&
+           "Test 2.2 failed: Intersection mismatch");
+    std::cout << "Test 2 passed: Read updates and intersection" << std::endl;
+}
+
+void testColumnarTimeFilter() {
+    std::cout << "\nTesting Columnar Time Filter..." << std::endl;
+    
+    // Test 3: Time windows
+    ColumnarMessageStore store;
+    for (int minute = 0; minute < 59; ++minute) {
+        struct Stamped {
+            DateTime time;
+            int getSenderId() const { return 1; }
+            int getReceiverId() const { return 2; }
+            const DateTime& getTimestamp() const { return time; }
+            bool isRead() const { return false; }
+        } message{DateTime(1, 6, 2024, 9, minute, 0)};
+        store.append(message);
+    }
+    auto window = store.matchBetween(DateTime(1, 6, 2024, 9, 10, 0), DateTime(1, 6, 2024, 9, 20, 0));
+    auto positions = ColumnarMessageStore::positions(window);
+    assert(positions.size() == 10 && positions.front() == 10 && positions.back() == 19 && "Test 3.1 failed: Window mismatch");
+    
+    try {
+        store.markAsRead(1000);
+        assert(false && "Test 3.2 failed: Out-of-range position should throw");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "ValidationError" && "Test 3.3 failed: Wrong exception type");
+    }
+    std::cout << "Test 3 passed: Time windows" << std::endl;
+}
+
+// The columns describe the resident timeline position for position, and
+// their unread filter agrees with the conversation's counters
+void checkColumns(const Conversation<Message>& conv, const char* failure) {
+    const ColumnarMessageStore* store = conv.getColumnarStore();
+    const auto& messages = conv.getMessages();
+    assert(store && store->size() == messages.size() && failure);
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        assert(store->getSenderId(i) == messages[i]->getSenderId() && failure);
+        assert(store->getReceiverId(i) == messages[i]->getReceiverId() && failure);
+        assert(store->getTimestamp(i) == messages[i]->getTimestamp() && failure);
+        assert((!messages[i]->isRead() || store->isRead(i)) && failure);
+    }
+    for (int user : {1, 2, 3}) {
+        assert(ColumnarMessageStore::countMatches(store->matchUnread(user)) == conv.unreadCount(user) && failure);
+    }
+}
+
+void testConversationColumns() {
+    std::cout << "\nTesting Columnar Conversation Storage..." << std::endl;
+    
+    // Test 4: Adds, late arrivals and batches keep the columns in timeline order
+    Conversation<Message> conv({1, 2, 3});
+    assert(!conv.getColumnarStore() && "Test 4.1 failed: Columns should be opt-in");
+    for (int i = 0; i < 10; ++i) {
+        conv.addMessage(std::make_shared<Message>(1 + i % 3, 1 + (i + 1) % 3, "Early", DateTime(4, 6, 2024, 9, 2 * i, 0)));
+    }
+    conv.enableColumnarStore();
+    checkColumns(conv, "Test 4.2 failed: Columns built from existing messages");
+    conv.addMessage(std::make_shared<Message>(2, 1, "Late", DateTime(4, 6, 2024, 9, 5, 0)));
+    conv.addMessage(std::make_shared<Message>(3, 2, "Newest", DateTime(4, 6, 2024, 9, 40, 0)));
+    checkColumns(conv, "Test 4.3 failed: Columns after single adds");
+    conv.addMessages({std::make_shared<Message>(1, 3, "Batch", DateTime(4, 6, 2024, 9, 45, 0)),
+                      std::make_shared<Message>(2, 3, "Batch", DateTime(4, 6, 2024, 9, 50, 0))});
+    checkColumns(conv, "Test 4.4 failed: Columns after an appended batch");
+    conv.addMessages({std::make_shared<Message>(3, 1, "Batch", DateTime(4, 6, 2024, 9, 1, 0)),
+                      std::make_shared<Message>(1, 2, "Batch", DateTime(4, 6, 2024, 9, 55, 0))});
+    checkColumns(conv, "Test 4.5 failed: Columns after a merged batch");
+    std::cout << "Test 4 passed: Columns follow the timeline" << std::endl;
+    
+    // Test 5: Reads through the conversation update the read column
+    conv.markAsRead(conv.getMessages()[3]);
+    checkColumns(conv, "Test 5.1 failed: Columns after markAsRead");
+    conv.markReadUpTo(2, DateTime(4, 6, 2024, 9, 10, 0));
+    checkColumns(conv, "Test 5.2 failed: Columns after markReadUpTo");
+    conv.markAllAsRead(3);
+    checkColumns(conv, "Test 5.3 failed: Columns after markAllAsRead");
+    conv.addMessage(std::make_shared<Message>(1, 3, "Behind watermark", DateTime(4, 6, 2024, 9, 3, 0)));
+    checkColumns(conv, "Test 5.4 failed: A message arriving behind the watermark counts as read");
+    assert(ColumnarMessageStore::countMatches(conv.getColumnarStore()->matchUnread(3)) == 0 &&
+           "Test 5.5 failed: Receiver 3 has read everything");
+    
+    auto fromAlice = conv.getMessagesAt(conv.getColumnarStore()->matchSender(1));
+    std::vector<std::shared_ptr<Message>> expected;
+    for (const auto& message : conv.getMessages()) {
+        if (message->getSenderId() == 1) expected.push_back(message);
+    }
+    assert(fromAlice == expected && "Test 5.6 failed: Messages at filtered positions");
+    std::cout << "Test 5 passed: Read column" << std::endl;
+    
+    // Test 6: Spilling and paging cold history keep the columns resident-only
+    conv.markAllAsRead(1);
+    conv.markAllAsRead(2);
+    conv.enableColdTier(4, 4);
+    assert(conv.getColdMessageCount() > 0 && "Test 6.1 failed: History should spill");
+    checkColumns(conv, "Test 6.2 failed: Columns after a spill");
+    conv.getLatestMessages(conv.getMessages().size() + conv.getColdMessageCount());
+    checkColumns(conv, "Test 6.3 failed: Columns after paging history in");
+    conv.addMessage(std::make_shared<Message>(2, 1, "After paging", DateTime(4, 6, 2024, 10, 0, 0)));
+    checkColumns(conv, "Test 6.4 failed: Columns after evicting paged-in history");
+    std::cout << "Test 6 passed: Columns with a cold tier" << std::endl;
+}
+
+int main() {
+    try {
+        testColumnarFilters();
+        testColumnarTimeFilter();
+        testConversationColumns();
+        std::cout << "\nAll ColumnarMessageStore unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,87 @@
+#include "../../include/user.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+User makeUser(int i) {
+    return User("user" + std::to_string(i) + "@posts.com", "User " + std::to_string(i), "pass123", "Male",
+                DateTime(1, 1, 1990));
+}
+
+// What operator+ used to compute, in ID order
+std::vector<Post*> reference(const User& a, const User& b) {
+    std::vector<Post*> common;
+    for (Post* mine : a.getPosts()) {
+        for (Post* theirs : b.getPosts()) {
+            if (mine == theirs) common.push_back(mine);
+        }
+    }
+    std::sort(common.begin(), common.end(),
+              [](Post* x, Post* y) { return PostRef{x->getId(), x} < PostRef{y->getId(), y}; });
+    return common;
+}
+
+void testCommonPosts() {
+    std::cout << "Testing Common Posts..." << std::endl;
+    User author = makeUser(0);
+    std::vector<std::unique_ptr<Post>> pool;
+    for (int i = 0; i < 2000; ++i) {
+        // Every ID is used twice: distinct posts with equal IDs are not common
+        pool.push_back(std::make_unique<Post>(i / 2, "Post", Post::Privacy::Public, &author));
+    }
+    std::mt19937 rng(3);
+
+    // Test 1: The view is empty without common posts and yields them in ID order
+    User alice = makeUser(1), bob = makeUser(2);
+    assert((alice + bob).empty() && "Test 1.1 failed: No posts, no common posts");
+    for (int i : {9, 4, 7, 1}) alice.addPost(pool[i].get());
+    for (int i : {1, 6, 7, 5, 9}) bob.addPost(pool[i].get());
+    std::vector<Post*> common = alice + bob;
+    assert(common == (std::vector<Post*>{pool[1].get(), pool[7].get(), pool[9].get()}) &&
+           "Test 1.2 failed: Common posts should come in ID order");
+    assert((bob + alice).count() == 3 && "Test 1.3 failed: Intersection should be symmetric");
+    std::cout << "Test 1 passed: Common posts in order" << std::endl;
+
+    // Test 2: Adding and removing posts updates the index
+    alice.removePost(pool[7].get());
+    auto gone = std::make_unique<Post>(4000, "Temporary", Post::Privacy::Public, &author);
+    alice.addPost(gone.get());
+    bob.addPost(gone.get());
+    assert((alice + bob).count() == 3 && "Test 2.1 failed: Added post should be common");
+    alice.removePost(gone.get());
+    bob.removePost(gone.get());
+    assert(std::vector<Post*>(alice + bob) == (std::vector<Post*>{pool[1].get(), pool[9].get()}) &&
+           "Test 2.2 failed: Removed posts should not be common");
+    std::cout << "Test 2 passed: Post removal" << std::endl;
+
+    // Test 3: Random post sets of similar and very different sizes match the
+    // nested-loop result
+    for (auto [aSize, bSize] : {std::pair<int, int>{300, 300}, {20, 1500}, {1500, 10}, {0, 50}}) {
+        User a = makeUser(3), b = makeUser(4);
+        for (int i = 0; i < aSize; ++i) a.addPost(pool[rng() % pool.size()].get());
+        for (int i = 0; i < bSize; ++i) b.addPost(pool[rng() % pool.size()].get());
+        std::vector<Post*> expected = reference(a, b);
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+        std::vector<Post*> actual = a + b;
+        actual.erase(std::unique(actual.begin(), actual.end()), actual.end());
+        assert(actual == expected && "Test 3.1 failed: Mismatch with nested-loop result");
+
+        User copy(a);
+        assert(std::vector<Post*>(copy + b) == std::vector<Post*>(a + b) && "Test 3.2 failed: Copy should keep index");
+    }
+    std::cout << "Test 3 passed: Random post sets" << std::endl;
+}
+
+int main() {
+    try {
+        testCommonPosts();
+        std::cout << "\nAll CommonPosts unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,4 +1,5 @@
 #include "../../include/conversation.h"
+#include "../../include/datetime.h"
 #include <cassert>
 #include <iostream>
 
@@ -8,13 +9,19 @@ public:
     int senderId;
     int receiverId;
     std::string content;
+    DateTime timestamp;
+    uint64_t sequence;
     bool read;
 
     MockMessage(int sender, int receiver, const std::string& msg)
-        : senderId(sender), receiverId(receiver), content(msg), read(false) {}
+        : senderId(sender), receiverId(receiver), content(msg),
+          timestamp(1, 1, 2024), sequence(0), read(false) {}
     
     int getSenderId() const { return senderId; }
     int getReceiverId() const { return receiverId; }
+    const DateTime& getTimestamp() const { return timestamp; }
+    uint64_t getSequence() const { return sequence; }
+    void setSequence(uint64_t value) { sequence = value; }
     bool isRead() const { return read; }
     void markAsRead() { read = true; }
 };
@@ -64,6 +71,9 @@ void testMessageManagement() {
     conv.addMessage(msg2);
     
     assert(conv.getMessages().size() == 2 && "Test 4.1 failed: Message count mismatch");
+    assert(conv.getMessages()[0] == msg1 && conv.getMessages()[1] == msg2 &&
+           "Test 4.2 failed: Same-timestamp messages should keep arrival order");
+    assert(msg2->getSequence() == msg1->getSequence() + 1 && "Test 4.3 failed: Sequence should be monotonic");
     std::cout << "Test 4 passed: Add messages" << std::endl;
     
     // Test 5: Invalid message (from non-participant)
@@ -97,18 +107,249 @@ void testMessageRetrieval() {
     
     auto user2Messages = conv.getMessagesByUser(2);
     assert(user2Messages.size() == 1 && "Test 6.2 failed: User 2 message count mismatch");
+    assert(user1Messages[0] == msg1 && user1Messages[1] == msg3 && "Test 6.3 failed: Sender index order mismatch");
+    assert(conv.getMessagesByUser(42).empty() && "Test 6.4 failed: Unknown sender should have no messages");
+    assert(user1Messages.subspan(1, 5).size() == 1 && "Test 6.5 failed: Subspan should clamp to the view");
     std::cout << "Test 6 passed: Get messages by user" << std::endl;
     
     // Test 7: Get unread messages
     auto unreadMessages = conv.getUnreadMessages(2);
     assert(unreadMessages.size() == 2 && "Test 7.1 failed: Unread message count mismatch");
     
-    msg1->markAsRead();
+    conv.markAsRead(msg1);
     unreadMessages = conv.getUnreadMessages(2);
     assert(unreadMessages.size() == 1 && "Test 7.2 failed: Unread message count after marking as read");
     std::cout << "Test 7 passed: Get unread messages" << std::endl;
 }
 
+void testReadTracking() {
+    std::cout << "\nTesting Read Tracking..." << std::endl;
+    
+    std::vector<int> participants = {1, 2};
+    Conversation<MockMessage> conv(participants);
+    std::vector<std::shared_ptr<MockMessage>> sent;
+    for (int i = 0; i < 5; ++i) {
+        sent.push_back(std::make_shared<MockMessage>(1, 2, "Message"));
+        sent.back()->timestamp = DateTime(1, 1, 2024, 10, i, 0);
+        conv.addMessage(sent.back());
+    }
+    conv.addMessage(std::make_shared<MockMessage>(2, 1, "Reply"));
+    
+    // Test 11: Unread counters
+    assert(conv.unreadCount(2) == 5 && "Test 11.1 failed: Unread count mismatch");
+    assert(conv.unreadCount(1) == 1 && "Test 11.2 failed: Unread count for sender mismatch");
+    assert(conv.unreadCount(3) == 0 && "Test 11.3 failed: Non-participant should have no unread messages");
+    conv.markAsRead(sent[4]);
+    assert(sent[4]->isRead() && "Test 11.4 failed: Message should be marked as read");
+    assert(conv.unreadCount(2) == 4 && "Test 11.5 failed: Unread count after markAsRead");
+    conv.markAsRead(sent[4]);
+    assert(conv.unreadCount(2) == 4 && conv.getUnreadMessages(2).size() == 4 &&
+           "Test 11.6 failed: Reading twice should count once");
+    
+    // Only reads through the conversation count, for the counter and the list alike
+    sent[3]->markAsRead();
+    assert(conv.unreadCount(2) == 4 && conv.getUnreadMessages(2).size() == 4 &&
+           "Test 11.7 failed: Counter and unread list should agree");
+    conv.markAsRead(sent[3]);
+    assert(conv.unreadCount(2) == 3 && conv.getUnreadMessages(2).size() == 3 &&
+           "Test 11.8 failed: Read through the conversation after a direct flag");
+    
+    // Messages from another conversation are rejected
+    Conversation<MockMessage> other(participants);
+    auto foreign = std::make_shared<MockMessage>(1, 2, "Elsewhere");
+    other.addMessage(foreign);
+    try {
+        conv.markAsRead(foreign);
+        assert(false && "Test 11.9 failed: Foreign message should be rejected");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "ValidationError" && conv.unreadCount(2) == 3 && other.unreadCount(2) == 1 &&
+               "Test 11.10 failed: Foreign message should change no counters");
+    }
+    std::cout << "Test 11 passed: Unread counters" << std::endl;
+    
+    // Test 12: Watermark up to a time
+    conv.markReadUpTo(2, DateTime(1, 1, 2024, 10, 1, 0));
+    assert(conv.unreadCount(2) == 1 && "Test 12.1 failed: Unread count after watermark");
+    auto unread = conv.getUnreadMessages(2);
+    assert(unread.size() == 1 && unread[0] == sent[2] && "Test 12.2 failed: Unread messages after watermark");
+    
+    // Test 13: Late message behind the watermark counts as read
+    auto late = std::make_shared<MockMessage>(1, 2, "Late");
+    late->timestamp = DateTime(1, 1, 2024, 9, 0, 0);
+    conv.addMessage(late);
+    assert(conv.unreadCount(2) == 1 && "Test 13.1 failed: Late message should be behind the watermark");
+    
+    // Test 14: Mark everything read
+    conv.markAllAsRead(2);
+    assert(conv.unreadCount(2) == 0 && conv.getUnreadMessages(2).empty() && "Test 14.1 failed: Mark all as read");
+    auto newer = std::make_shared<MockMessage>(1, 2, "New");
+    newer->timestamp = DateTime(1, 1, 2024, 11, 0, 0);
+    conv.addMessage(newer);
+    assert(conv.unreadCount(2) == 1 && "Test 14.2 failed: New message after watermark should be unread");
+    std::cout << "Test 12-14 passed: Read watermarks" << std::endl;
+}
+
+void testPagination() {
+    std::cout << "\nTesting Pagination..." << std::endl;
+    
+    std::vector<int> participants = {1, 2};
+    Conversation<MockMessage> conv(participants);
+    std::vector<std::shared_ptr<MockMessage>> sent;
+    for (int i = 0; i < 10; ++i) {
+        sent.push_back(std::make_shared<MockMessage>(1, 2, "Message"));
+        sent.back()->timestamp = DateTime(1, 1, 2024, 12, i, 0);
+        conv.addMessage(sent.back());
+    }
+    
+    // Test 15: Position cursors
+    auto latest = conv.getLatestMessages(3);
+    assert(latest.size() == 3 && latest[0] == sent[7] && latest.back() == sent[9] && "Test 15.1 failed: Latest page mismatch");
+    auto older = conv.getMessagesBefore(conv.positionOf(latest[0]), 3);
+    assert(older.size() == 3 && older[0] == sent[4] && "Test 15.2 failed: Previous page mismatch");
+    auto oldest = conv.getMessagesBefore(2, 5);
+    assert(oldest.size() == 2 && oldest[0] == sent[0] && "Test 15.3 failed: First page should be clamped");
+    auto newer = conv.getMessagesAfter(conv.positionOf(sent[8]), 5);
+    assert(newer.size() == 1 && newer[0] == sent[9] && "Test 15.4 failed: Next page mismatch");
+    auto missing = std::make_shared<MockMessage>(1, 2, "Not added");
+    assert(conv.positionOf(missing) == Conversation<MockMessage>::npos && "Test 15.5 failed: Unknown message position");
+    std::cout << "Test 15 passed: Position cursors" << std::endl;
+    
+    // Test 16: Time cursors and windows
+    auto beforeTime = conv.getMessagesBefore(DateTime(1, 1, 2024, 12, 5, 0), 2);
+    assert(beforeTime.size() == 2 && beforeTime[0] == sent[3] && beforeTime[1] == sent[4] && "Test 16.1 failed: Before time mismatch");
+    auto afterTime = conv.getMessagesAfter(DateTime(1, 1, 2024, 12, 5, 0), 2);
+    assert(afterTime.size() == 2 && afterTime[0] == sent[6] && "Test 16.2 failed: After time mismatch");
+    auto window = conv.getMessagesBetween(DateTime(1, 1, 2024, 12, 2, 0), DateTime(1, 1, 2024, 12, 6, 0));
+    assert(window.size() == 4 && window[0] == sent[2] && window.back() == sent[5] && "Test 16.3 failed: Window mismatch");
+    assert(conv.getMessagesBetween(DateTime(1, 1, 2025), DateTime(1, 1, 2026)).empty() && "Test 16.4 failed: Empty window");
+    const std::size_t unlimited = static_cast<std::size_t>(-1);
+    assert(conv.getMessagesAfter(0, unlimited).size() == 9 && conv.getMessagesAfter(0, unlimited)[0] == sent[1] &&
+           "Test 16.5 failed: Unbounded limit after a position");
+    assert(conv.getMessagesAfter(DateTime(1, 1, 2024, 12, 5, 0), unlimited).size() == 4 &&
+           conv.getMessagesBefore(DateTime(1, 1, 2024, 12, 5, 0), unlimited).size() == 5 &&
+           "Test 16.6 failed: Unbounded limit around a time");
+    std::cout << "Test 16 passed: Time windows" << std::endl;
+}
+
+void testBulkAdd() {
+    std::cout << "\nTesting Bulk Add..." << std::endl;
+    
+    std::vector<int> participants = {1, 2};
+    Conversation<MockMessage> conv(participants);
+    auto existing = std::make_shared<MockMessage>(1, 2, "Existing");
+    existing->timestamp = DateTime(1, 1, 2024, 12, 0, 0);
+    conv.addMessage(existing);
+    conv.markAllAsRead(2);
+    
+    // Test 19: Out-of-order batch with invalid rows
+    std::vector<std::shared_ptr<MockMessage>> batch;
+    for (int minute : {30, 10, 20}) {
+        batch.push_back(std::make_shared<MockMessage>(2, 1, "Reply"));
+        batch.back()->timestamp = DateTime(1, 1, 2024, 12, minute, 0);
+    }
+    batch.push_back(nullptr);
+    batch.push_back(std::make_shared<MockMessage>(1, 3, "Outsider"));
+    auto early = std::make_shared<MockMessage>(1, 2, "Early");
+    early->timestamp = DateTime(1, 1, 2024, 11, 0, 0);
+    batch.push_back(early);
+    
+    auto rejected = conv.addMessages(batch);
+    assert(rejected.size() == 2 && rejected[0].index == 3 && rejected[1].index == 4 &&
+           "Test 19.1 failed: Invalid rows should be reported");
+    const auto& messages = conv.getMessages();
+    assert(messages.size() == 5 && "Test 19.2 failed: Valid rows should be added");
+    assert(messages[0] == early && messages[1] == existing && messages[2] == batch[1] &&
+           messages[3] == batch[2] && messages[4] == batch[0] && "Test 19.3 failed: Merged timeline out of order");
+    assert(batch[0]->getSequence() == 2 && early->getSequence() == 5 && conv.getLastSequence() == 5 &&
+           "Test 19.4 failed: Sequences should follow batch order");
+    std::cout << "Test 19 passed: Bulk add with rejections" << std::endl;
+    
+    // Test 20: Sender index and read state match one-by-one adds
+    assert(conv.getMessagesByUser(2).size() == 3 && conv.getMessagesByUser(2)[0] == batch[1] &&
+           "Test 20.1 failed: Sender index after bulk add");
+    assert(conv.unreadCount(1) == 3 && "Test 20.2 failed: Receiver unread count after bulk add");
+    assert(conv.unreadCount(2) == 0 && conv.getUnreadMessages(2).empty() &&
+           "Test 20.3 failed: Message behind the watermark should count as read");
+    assert(conv.addMessages({}).empty() && conv.getMessages().size() == 5 && "Test 20.4 failed: Empty batch");
+    std::cout << "Test 20 passed: Bulk add indexes" << std::endl;
+}
+
+void testDeltaSync() {
+    std::cout << "\nTesting Delta Sync..." << std::endl;
+    
+    std::vector<int> participants = {1, 2};
+    Conversation<MockMessage> conv(participants);
+    conv.enableChangeLog();
+    assert(conv.getChangeSequence() == 0 && conv.changesSince(0).changes.empty() && "Test 21.1 failed: New conversation has no changes");
+    std::vector<std::shared_ptr<MockMessage>> sent;
+    for (int i = 0; i < 4; ++i) {
+        sent.push_back(std::make_shared<MockMessage>(1, 2, "Message"));
+        sent.back()->timestamp = DateTime(1, 1, 2024, 13, i, 0);
+        conv.addMessage(sent.back());
+    }
+    
+    // Test 21: A client that synced after two messages gets only the rest
+    auto delta = conv.changesSince(2);
+    assert(delta.changes.size() == 2 && delta.cursor == 4 && !delta.fullResync && "Test 21.2 failed: Delta size");
+    assert(delta.changes[0].type == ChangeType::MessageAdded && delta.changes[0].message == sent[2] &&
+           delta.changes[0].sequence == 3 && delta.changes[1].message == sent[3] && "Test 21.3 failed: Delta content");
+    assert(conv.changesSince(4).changes.empty() && conv.changesSince(99).changes.empty() && "Test 21.4 failed: Up-to-date client");
+    std::cout << "Test 21 passed: Message deltas" << std::endl;
+    
+    // Test 22: Read changes are part of the delta
+    conv.markAsRead(sent[0]);
+    conv.markAsRead(sent[0]);  // Already read: no change
+    conv.markReadUpTo(2, DateTime(1, 1, 2024, 13, 1, 0));
+    conv.markReadUpTo(2, DateTime(1, 1, 2024, 13, 1, 0));  // Watermark did not move
+    conv.markAllAsRead(2);
+    conv.markAllAsRead(2);
+    delta = conv.changesSince(4);
+    assert(delta.changes.size() == 3 && delta.cursor == 7 && "Test 22.1 failed: Read change count");
+    assert(delta.changes[0].type == ChangeType::MessageRead && delta.changes[0].message == sent[0] &&
+           "Test 22.2 failed: Single read change");
+    assert(delta.changes[1].type == ChangeType::ReadUpTo && delta.changes[1].message == sent[1] &&
+           delta.changes[1].userId == 2 && "Test 22.3 failed: Watermark change");
+    assert(delta.changes[2].type == ChangeType::ReadUpTo && delta.changes[2].message == sent[3] &&
+           "Test 22.4 failed: Mark all change");
+    conv.addMessages({std::make_shared<MockMessage>(2, 1, "Bulk")});
+    assert(conv.changesSince(7).changes.size() == 1 && "Test 22.5 failed: Bulk add should be logged");
+    std::cout << "Test 22 passed: Read deltas" << std::endl;
+    
+    // Test 23: Trimmed history forces a full resync
+    conv.trimChanges(5);
+    assert(conv.getChangeSequence() == 8 && "Test 23.1 failed: Trimming keeps the sequence");
+    assert(conv.changesSince(5).changes.size() == 3 && !conv.changesSince(5).fullResync && "Test 23.2 failed: Cursor at trim point");
+    auto stale = conv.changesSince(2);
+    assert(stale.fullResync && stale.changes.empty() && stale.cursor == 8 && "Test 23.3 failed: Stale cursor");
+    conv.trimChanges(100);
+    assert(conv.changesSince(8).changes.empty() && !conv.changesSince(8).fullResync && "Test 23.4 failed: Trim everything");
+    std::cout << "Test 23 passed: Trimmed change log" << std::endl;
+    
+    // Test 24: The log is off by default and bounded once on
+    Conversation<MockMessage> quiet(participants);
+    auto unlogged = std::make_shared<MockMessage>(1, 2, "Unlogged");
+    quiet.addMessage(unlogged);
+    assert(quiet.getChangeSequence() == 1 && quiet.changesSince(0).fullResync && "Test 24.1 failed: Log should be off");
+    quiet.enableChangeLog(3);
+    for (int i = 0; i < 5; ++i) {
+        auto message = std::make_shared<MockMessage>(2, 1, "Logged");
+        message->timestamp = DateTime(1, 1, 2024, 14, i, 0);
+        quiet.addMessage(message);
+    }
+    delta = quiet.changesSince(3);
+    assert(quiet.getChangeSequence() == 6 && delta.changes.size() == 3 && !delta.fullResync &&
+           delta.changes[0].sequence == 4 && "Test 24.2 failed: Log should keep its newest entries");
+    assert(quiet.changesSince(2).fullResync && "Test 24.3 failed: Clients past the capacity should resync");
+    for (int i = 0; i < 100; ++i) {
+        quiet.markAllAsRead(1);
+        quiet.addMessage(std::make_shared<MockMessage>(2, 1, "More"));
+    }
+    assert(quiet.changesSince(quiet.getChangeSequence() - 3).changes.size() == 3 &&
+           quiet.changesSince(quiet.getChangeSequence() - 3).changes[2].sequence == quiet.getChangeSequence() &&
+           "Test 24.4 failed: Sequences after compaction");
+    std::cout << "Test 24 passed: Opt-in bounded change log" << std::endl;
+}
+
 void testParticipantManagement() {
     std::cout << "\nTesting Participant Management..." << std::endl;
     
@@ -137,12 +378,51 @@ void testParticipantManagement() {
     std::cout << "Test 10 passed: Invalid participant operations" << std::endl;
 }
 
+void testDirectConversation() {
+    std::cout << "\nTesting Direct Conversation..." << std::endl;
+    
+    // Test 17: Two-party conversations
+    Conversation<MockMessage, DirectPolicy> direct({1, 2});
+    assert(direct.getParticipants() == std::vector<int>({1, 2}) && "Test 17.1 failed: Participants mismatch");
+    assert(direct.isParticipant(1) && direct.isParticipant(2) && !direct.isParticipant(3) && "Test 17.2 failed: Membership mismatch");
+    direct.addMessage(std::make_shared<MockMessage>(1, 2, "Hi"));
+    direct.addMessage(std::make_shared<MockMessage>(2, 1, "Hello"));
+    assert(direct.getMessages().size() == 2 && direct.unreadCount(1) == 1 && "Test 17.3 failed: Message handling mismatch");
+    std::cout << "Test 17 passed: Direct conversation messages" << std::endl;
+    
+    // Test 18: Direct conversation validation
+    try {
+        direct.addMessage(std::make_shared<MockMessage>(1, 3, "Outsider"));
+        assert(false && "Test 18.1 failed: Should reject non-participant receiver");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "ValidationError" && "Test 18.2 failed: Wrong exception type");
+    }
+    try {
+        direct.addParticipant(3);
+        assert(false && "Test 18.3 failed: Direct conversation should not grow");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "ValidationError" && "Test 18.4 failed: Wrong exception type");
+    }
+    try {
+        Conversation<MockMessage, DirectPolicy> group({1, 2, 3});
+        assert(false && "Test 18.5 failed: Direct conversation needs exactly two participants");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "ValidationError" && "Test 18.6 failed: Wrong exception type");
+    }
+    std::cout << "Test 18 passed: Direct conversation validation" << std::endl;
+}
+
 int main() {
     try {
         testConversationCreation();
         testMessageManagement();
         testMessageRetrieval();
+        testReadTracking();
+        testPagination();
+        testBulkAdd();
+        testDeltaSync();
         testParticipantManagement();
+        testDirectConversation();
         
         std::cout << "\nAll conversation tests passed successfully!" << std::endl;
         return 0;
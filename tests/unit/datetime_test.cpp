@@ -52,6 +52,66 @@ void testDateTimeComparison() {
     std::cout << "Test 4 passed: Date comparison" << std::endl;
 }
 
+void testDateTimePacking() {
+    std::cout << "\nTesting DateTime Packing..." << std::endl;
+    
+    // Test 6: Packed representation
+    assert(sizeof(DateTime) == 8 && "Test 6.1 failed: DateTime should be a single 64-bit word");
+    DateTime dt1(31, 12, 2023, 23, 59, 59);
+    DateTime dt2(1, 1, 2024);
+    assert(dt1.getTicks() < dt2.getTicks() && "Test 6.2 failed: Ticks should follow chronological order");
+    assert(DateTime::fromTicks(dt1.getTicks()) == dt1 && "Test 6.3 failed: Ticks round trip mismatch");
+    
+    // Test 7: Out-of-range fields stay invalid
+    assert(!DateTime(40, 1, 2024).isValid() && "Test 7.1 failed: Day out of range should be invalid");
+    assert(!DateTime(1, 1, 2024, 24, 0, 0).isValid() && "Test 7.2 failed: Hour out of range should be invalid");
+    assert(!DateTime(1, 1, 2024, -1, 0, 0).isValid() && "Test 7.3 failed: Negative hour should be invalid");
+    assert(DateTime(1, 1, 1970).toEpochSeconds() == 0 && "Test 7.4 failed: Epoch mismatch");
+    assert(DateTime(29, 2, 2024, 12, 0, 0).toEpochSeconds() == 1709208000 && "Test 7.5 failed: Epoch seconds mismatch");
+    std::cout << "Test 6-7 passed: Date packing" << std::endl;
+}
+
+void testDateTimeParsing() {
+    std::cout << "\nTesting DateTime Parsing..." << std::endl;
+    
+    // Test 8: Buffer formatting and string_view parsing round trip
+    DateTime dt1(15, 3, 2024, 14, 30, 45);
+    char buffer[DateTime::MAX_SERIALIZED_LENGTH];
+    std::size_t length = dt1.formatTo(buffer);
+    assert(std::string(buffer, length) == dt1.serialize() && "Test 8.1 failed: formatTo/serialize mismatch");
+    DateTime parsed(0, 0, 0);
+    assert(DateTime::parse(std::string_view(buffer, length), parsed) && "Test 8.2 failed: Parse should succeed");
+    assert(parsed == dt1 && "Test 8.3 failed: Round trip mismatch");
+    assert(DateTime::deserialize("2024-03-15 14:30:45").getHour() == 14 && "Test 8.4 failed: Hour mismatch");
+    
+    // Test 9: Date-only text and garbage
+    assert(DateTime::deserialize("2024-03-15") == DateTime(15, 3, 2024) && "Test 9.1 failed: Date-only parse mismatch");
+    assert(!DateTime::parse("not a date", parsed) && "Test 9.2 failed: Garbage should not parse");
+    assert(!DateTime::deserialize("2024/03").isValid() && "Test 9.3 failed: Garbage should deserialize as invalid");
+    assert(!DateTime::parse("2024-03-15xyz", parsed) && !DateTime::parse("2024-03-15 14:30:45 ", parsed) &&
+           "Test 9.4 failed: Trailing garbage should not parse");
+    assert(!DateTime::parse("12345678901-03-15", parsed) && !DateTime::parse("2024-0000000003-15", parsed) &&
+           !DateTime::parse("2024-03-15 14:30:45.1234567890", parsed) &&
+           "Test 9.5 failed: Overlong numeric fields should not parse");
+    assert(DateTime::parse("2024-03-15 14:30:45.123456789", parsed) && parsed.getMicrosecond() == 123456 &&
+           "Test 9.6 failed: Nanosecond fractions should truncate to microseconds");
+    
+    // Test 10: Batch parsing
+    std::vector<DateTime> batch = DateTime::deserializeBatch({"2024-01-01 00:00:01", "bad", "1999-12-31 23:59:59"});
+    assert(batch.size() == 3 && "Test 10.1 failed: Batch size mismatch");
+    assert(batch[0] == DateTime(1, 1, 2024, 0, 0, 1) && "Test 10.2 failed: Batch entry mismatch");
+    assert(!batch[1].isValid() && "Test 10.3 failed: Bad batch entry should be invalid");
+    assert(batch[2] < batch[0] && "Test 10.4 failed: Batch ordering mismatch");
+    
+    // Test 11: Microseconds
+    DateTime precise(15, 3, 2024, 14, 30, 45, 1500);
+    assert(precise.serialize() == "2024-03-15 14:30:45.001500" && "Test 11.1 failed: Microsecond format mismatch");
+    assert(DateTime::deserialize(precise.serialize()) == precise && "Test 11.2 failed: Microsecond round trip mismatch");
+    assert(DateTime::deserialize("2024-03-15 14:30:45.25").getMicrosecond() == 250000 && "Test 11.3 failed: Short fraction mismatch");
+    assert(dt1 < precise && precise < DateTime(15, 3, 2024, 14, 30, 46) && "Test 11.4 failed: Microsecond ordering");
+    std::cout << "Test 8-11 passed: Date parsing" << std::endl;
+}
+
 void testDateTimeFormatting() {
     std::cout << "\nTesting DateTime Formatting..." << std::endl;
     
@@ -69,6 +129,8 @@ int main() {
         testDateTimeCreation();
         testDateTimeValidation();
         testDateTimeComparison();
+        testDateTimePacking();
+        testDateTimeParsing();
         testDateTimeFormatting();
         std::cout << "\nAll DateTime unit tests passed successfully!" << std::endl;
         return 0;
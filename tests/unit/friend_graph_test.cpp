@@ -0,0 +1,215 @@
+#include "../../include/friend_graph.h"
+#include "../../include/user.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+std::unique_ptr<User> makeUser(int i) {
+    return std::make_unique<User>("user" + std::to_string(i) + "@graph.com", "User " + std::to_string(i),
+                                  "pass123", "Female", DateTime(1, 1, 1990));
+}
+
+void testBasicFriendships() {
+    std::cout << "Testing Friend Graph Basics..." << std::endl;
+    FriendGraph& graph = FriendGraph::getInstance();
+
+    // Test 1: Friendships are mutual, restricted flags are per side
+    auto alice = makeUser(1), bob = makeUser(2), carol = makeUser(3);
+    alice->addFriend(bob.get(), true);
+    assert(alice->isFriend(bob.get()) && bob->isFriend(alice.get()) && "Test 1.1 failed: Friendship should be mutual");
+    assert(alice->isRestrictedFriend(bob.get()) && !bob->isRestrictedFriend(alice.get()) &&
+           "Test 1.2 failed: Restricted flag belongs to one side");
+    bob->addFriend(alice.get(), true);
+    alice->addFriend(bob.get(), false);
+    assert(!alice->isRestrictedFriend(bob.get()) && bob->isRestrictedFriend(alice.get()) &&
+           "Test 1.3 failed: Flags should update independently");
+    assert(!alice->isFriend(carol.get()) && !alice->isFriend(nullptr) && "Test 1.4 failed: Non-friends");
+
+    // Test 2: Node IDs are dense and map back to users
+    assert(graph.getUser(alice->getGraphId()) == alice.get() && "Test 2.1 failed: Node should map to its user");
+    assert(graph.getFriends(alice->getGraphId()) == std::vector<FriendGraph::NodeId>{bob->getGraphId()} &&
+           "Test 2.2 failed: Friend list mismatch");
+
+    // Test 3: Destroyed users leave no friendships behind and their IDs are reused
+    FriendGraph::NodeId carolId = carol->getGraphId();
+    carol->addFriend(alice.get());
+    carol.reset();
+    assert(graph.getFriends(alice->getGraphId()).size() == 1 && "Test 3.1 failed: Removed user's edges remain");
+    auto dave = makeUser(4);
+    assert(dave->getGraphId() == carolId && graph.getFriends(carolId).empty() &&
+           "Test 3.2 failed: Reused ID should start without friends");
+
+    // Test 4: A copy is a new node that leaves others' friendships alone,
+    // while a move carries the node and its friendships along
+    alice->addFriend(dave.get(), true);
+    {
+        User copy(*alice);
+        assert(copy.getGraphId() != alice->getGraphId() && "Test 4.1 failed: Copy should get its own node");
+        assert(graph.getFriends(copy.getGraphId()).empty() && !bob->isFriend(&copy) &&
+               graph.getFriends(bob->getGraphId()).size() == 1 && "Test 4.2 failed: Copy should not add friendships");
+        copy = *bob;
+        assert(graph.getFriends(copy.getGraphId()).empty() && graph.getFriends(bob->getGraphId()).size() == 1 &&
+               "Test 4.3 failed: Copy assignment should not add friendships");
+    }
+    {
+        FriendGraph::NodeId bobId = bob->getGraphId();
+        User moved(std::move(*bob));
+        assert(moved.getGraphId() == bobId && graph.getUser(bobId) == &moved &&
+               "Test 4.4 failed: Move should take over the node");
+        assert(moved.isFriend(alice.get()) && alice->isFriend(&moved) &&
+               graph.getFriends(alice->getGraphId()).size() == 2 && "Test 4.5 failed: Move should keep the friendships");
+        *bob = std::move(moved);
+        assert(bob->getGraphId() == bobId && graph.getUser(bobId) == bob.get() && alice->isFriend(bob.get()) &&
+               "Test 4.6 failed: Move assignment should take over the node");
+    }
+    std::vector<User> grown;
+    grown.push_back(*makeUser(5));
+    grown.back().addFriend(bob.get());
+    for (int i = 0; i < 16; ++i) {
+        grown.push_back(*makeUser(6 + i));
+    }
+    assert(graph.getFriends(bob->getGraphId()).size() == 2 && graph.getUser(grown[0].getGraphId()) == &grown[0] &&
+           bob->isFriend(&grown[0]) && "Test 4.7 failed: Reallocation should move users, not copy them");
+    grown.clear();
+    assert(graph.getFriends(bob->getGraphId()).size() == 1 && (*bob & *dave).size() == 1 &&
+           "Test 4.8 failed: Removed users' friendships should be gone");
+    std::cout << "Test 1-4 passed: Friend graph basics" << std::endl;
+}
+
+void testDeltaAndCompaction() {
+    std::cout << "\nTesting Delta Layer and Compaction..." << std::endl;
+    FriendGraph& graph = FriendGraph::getInstance();
+
+    // Test 5: After random edits, friend lists and mutual friends match a
+    // reference model, before and after compaction
+    const int count = 200;
+    std::vector<std::unique_ptr<User>> users;
+    for (int i = 0; i < count; ++i) {
+        users.push_back(makeUser(100 + i));
+    }
+    std::map<std::pair<int, int>, bool> model;  // (user, friend) -> restricted
+    std::mt19937 rng(7);
+    bool compacted = false;
+    for (int step = 0; step < 20000; ++step) {
+        int a = rng() % count, b = rng() % count;
+        if (a == b) continue;
+        if (rng() % 4 == 0) {
+            users[a]->removeFriend(users[b].get());
+            model.erase({a, b});
+            model.erase({b, a});
+        } else {
+            bool restricted = rng() % 3 == 0;
+            users[a]->addFriend(users[b].get(), restricted);
+            model[{a, b}] = restricted;
+            model.emplace(std::make_pair(b, a), false);
+        }
+        compacted = compacted || graph.getDeltaSize() == 0;
+    }
+    assert(compacted && "Test 5.1 failed: Delta should have been compacted along the way");
+    auto check = [&](const char* failure) {
+        for (int a = 0; a < count; ++a) {
+            std::vector<User*> regular, restricted;
+            for (auto it = model.lower_bound({a, 0}); it != model.end() && it->first.first == a; ++it) {
+                (it->second ? restricted : regular).push_back(users[it->first.second].get());
+            }
+            auto sameUsers = [](std::vector<User*> x, std::vector<User*> y) {
+                std::sort(x.begin(), x.end());
+                std::sort(y.begin(), y.end());
+                return x == y;
+            };
+            assert(sameUsers(users[a]->getFriends(false), regular) && failure);
+            assert(sameUsers(users[a]->getFriends(true), restricted) && failure);
+            for (int c = 0; c < count; ++c) {
+                auto edge = model.find({a, c});
+                FriendGraph::Relation expected = edge == model.end() ? FriendGraph::Relation::None
+                                                 : edge->second    ? FriendGraph::Relation::Restricted
+                                                                   : FriendGraph::Relation::Regular;
+                assert(users[a]->getRelation(users[c].get()) == expected && failure);
+            }
+
+            int b = (a * 37 + 11) % count;
+            std::vector<User*> mutual;
+            for (int c = 0; c < count; ++c) {
+                if (c != a && c != b && model.count({a, c}) && model.count({b, c})) {
+                    mutual.push_back(users[c].get());
+                }
+            }
+            assert(sameUsers(*users[a] & *users[b], mutual) && failure);
+            assert(users[a]->countMutualFriends(*users[b]) == mutual.size() && failure);
+        }
+    };
+    check("Test 5.2 failed: Friend lists with a pending delta");
+    graph.compact();
+    assert(graph.getDeltaSize() == 0 && "Test 5.3 failed: Compaction should empty the delta");
+    check("Test 5.4 failed: Friend lists after compaction");
+
+    // Test 6: Statistics
+    assert(graph.edgeCount() == model.size() && "Test 6.1 failed: Edge count mismatch");
+    assert(graph.userCount() == static_cast<size_t>(count) && "Test 6.2 failed: User count mismatch");
+    std::cout << "Test 5-6 passed: Delta layer and compaction" << std::endl;
+}
+
+void testFriendLists() {
+    std::cout << "\nTesting Partitioned Friend Lists..." << std::endl;
+    FriendGraph& graph = FriendGraph::getInstance();
+
+    // Test 7: Each list is a sorted range over the graph, one per partition
+    std::vector<std::unique_ptr<User>> users;
+    for (int i = 0; i < 8; ++i) {
+        users.push_back(makeUser(500 + i));
+    }
+    for (int i : {5, 1, 7, 3}) users[0]->addFriend(users[i].get(), false);
+    for (int i : {6, 2}) users[0]->addFriend(users[i].get(), true);
+    auto check = [&](const char* failure) {
+        FriendGraph::UserList regular = users[0]->getFriends(false);
+        FriendGraph::UserList restricted = users[0]->getFriends(true);
+        assert(regular.size() == 4 && restricted.size() == 2 && failure);
+        // Node IDs are reused, so ID order is not creation order
+        bool twoFirst = users[2]->getGraphId() < users[6]->getGraphId();
+        assert(std::vector<User*>(restricted) == (twoFirst ? std::vector<User*>{users[2].get(), users[6].get()}
+                                                          : std::vector<User*>{users[6].get(), users[2].get()}) &&
+               failure);
+        Span<FriendGraph::NodeId> ids = graph.getFriendList(users[0]->getGraphId(), false);
+        assert(std::is_sorted(ids.begin(), ids.end()) && failure);
+        for (size_t i = 0; i < regular.size(); ++i) {
+            assert(regular[i] == graph.getUser(ids[i]) && !users[0]->isRestrictedFriend(regular[i]) && failure);
+        }
+    };
+    check("Test 7.1 failed: Lists with edited rows");
+    graph.compact();
+    check("Test 7.2 failed: Lists after compaction");
+
+    // Test 8: Changing a flag moves the friend between partitions
+    users[0]->addFriend(users[3].get(), true);
+    users[0]->addFriend(users[6].get(), false);
+    assert(users[0]->getRelation(users[3].get()) == FriendGraph::Relation::Restricted &&
+           users[0]->getRelation(users[6].get()) == FriendGraph::Relation::Regular &&
+           "Test 8.1 failed: Flag change should move the friend");
+    size_t regularCount = 0;
+    for (User* user : users[0]->getFriends(false)) {
+        assert(!users[0]->isRestrictedFriend(user) && "Test 8.2 failed: Restricted friend in regular list");
+        ++regularCount;
+    }
+    assert(regularCount == 4 && users[0]->getFriends(true).size() == 2 && "Test 8.3 failed: Partition sizes");
+    assert(users[3]->getRelation(users[0].get()) == FriendGraph::Relation::Regular &&
+           users[0]->getRelation(nullptr) == FriendGraph::Relation::None && "Test 8.4 failed: Other side's flag");
+    std::cout << "Test 7-8 passed: Partitioned friend lists" << std::endl;
+}
+
+int main() {
+    try {
+        testBasicFriendships();
+        testDeltaAndCompaction();
+        testFriendLists();
+        std::cout << "\nAll FriendGraph unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
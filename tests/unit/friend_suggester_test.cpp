@@ -0,0 +1,119 @@
+#include "../../include/friend_suggester.h"
+#include "../../include/user.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+using Suggestion = FriendSuggester::Suggestion;
+
+std::unique_ptr<User> makeUser(int i) {
+    return std::make_unique<User>("user" + std::to_string(i) + "@suggest.com", "User " + std::to_string(i),
+                                  "pass123", "Male", DateTime(1, 1, 1990));
+}
+
+// Friends of friends counted with nested friend lists and a full sort
+std::vector<Suggestion> reference(const FriendGraph& graph, FriendGraph::NodeId u, size_t limit) {
+    std::vector<FriendGraph::NodeId> friends = graph.getFriends(u);
+    std::set<FriendGraph::NodeId> excluded(friends.begin(), friends.end());
+    excluded.insert(u);
+    std::map<FriendGraph::NodeId, uint32_t> counts;
+    for (FriendGraph::NodeId f : friends) {
+        for (FriendGraph::NodeId w : graph.getFriends(f)) {
+            if (!excluded.count(w)) ++counts[w];
+        }
+    }
+    std::vector<Suggestion> all;
+    for (const auto& [w, count] : counts) all.push_back({w, count});
+    std::sort(all.begin(), all.end(), [](const Suggestion& a, const Suggestion& b) {
+        return a.mutualFriends != b.mutualFriends ? a.mutualFriends > b.mutualFriends : a.user < b.user;
+    });
+    if (all.size() > limit) all.resize(limit);
+    return all;
+}
+
+void testSingleUser() {
+    std::cout << "Testing Friend Suggestions..." << std::endl;
+    FriendGraph& graph = FriendGraph::getInstance();
+    FriendSuggester suggester;
+
+    // Test 1: Friends of friends ranked by mutual friends, friends and self left out
+    std::vector<std::unique_ptr<User>> users;
+    for (int i = 0; i < 7; ++i) users.push_back(makeUser(i));
+    // 0 - {1, 2, 3}; 4 knows 1, 2 and 3; 5 knows 1 and 2 (restricted); 6 knows 3; 1 knows 2
+    for (int i : {1, 2, 3}) users[0]->addFriend(users[i].get());
+    for (int i : {1, 2, 3}) users[4]->addFriend(users[i].get());
+    users[5]->addFriend(users[1].get());
+    users[5]->addFriend(users[2].get(), true);
+    users[6]->addFriend(users[3].get());
+    users[1]->addFriend(users[2].get());
+    std::vector<User*> suggested = users[0]->suggestFriends(10);
+    bool fiveFirst = users[5]->getGraphId() < users[6]->getGraphId();
+    assert(suggested.size() == 3 && suggested[0] == users[4].get() && "Test 1.1 failed: Most mutual friends first");
+    assert(suggested[1] == users[5].get() && suggested[2] == users[6].get() &&
+           "Test 1.2 failed: Restricted friendships count as friendships");
+    auto top = suggester.suggestFor(users[0]->getGraphId(), 10);
+    assert(top[0].mutualFriends == 3 && top[1].mutualFriends == 2 && top[2].mutualFriends == 1 &&
+           "Test 1.3 failed: Mutual friend counts");
+    std::cout << "Test 1 passed: Ranking and exclusion" << std::endl;
+
+    // Test 2: Limits, ties and users without suggestions
+    users[6]->addFriend(users[2].get());
+    top = suggester.suggestFor(users[0]->getGraphId(), 2);
+    FriendGraph::NodeId tieFirst = fiveFirst ? users[5]->getGraphId() : users[6]->getGraphId();
+    assert(top.size() == 2 && top[0].user == users[4]->getGraphId() && top[1].user == tieFirst &&
+           "Test 2.1 failed: Ties should go to the lower ID");
+    assert(suggester.suggestFor(users[0]->getGraphId(), 0).empty() && "Test 2.2 failed: Zero limit");
+    auto loner = makeUser(7);
+    assert(loner->suggestFriends(5).empty() && "Test 2.3 failed: No friends, no suggestions");
+    assert(suggester.suggestFor(static_cast<FriendGraph::NodeId>(graph.nodeIdLimit() + 5), 5).empty() &&
+           "Test 2.4 failed: Unknown user");
+    std::cout << "Test 2 passed: Limits and ties" << std::endl;
+}
+
+void testBatch() {
+    std::cout << "\nTesting Batch Suggestions..." << std::endl;
+    FriendGraph& graph = FriendGraph::getInstance();
+    FriendSuggester suggester;
+
+    // Test 3: On a random graph with hubs, single queries match the reference
+    std::vector<std::unique_ptr<User>> users;
+    std::mt19937 rng(21);
+    for (int i = 0; i < 400; ++i) users.push_back(makeUser(100 + i));
+    for (int i = 0; i < 3000; ++i) {
+        int a = rng() % 400;
+        int b = rng() % 3 == 0 ? rng() % 8 : rng() % 400;  // Users 0-7 are hubs
+        users[a]->addFriend(users[b].get(), rng() % 5 == 0);
+    }
+    for (int i = 0; i < 400; i += 7) {
+        FriendGraph::NodeId u = users[i]->getGraphId();
+        assert(suggester.suggestFor(u, 10) == reference(graph, u, 10) && "Test 3.1 failed: Single-user mismatch");
+    }
+    std::cout << "Test 3 passed: Single-user queries" << std::endl;
+
+    // Test 4: The batch run gives the same answers on any number of threads
+    auto serial = suggester.suggestAll(10, 1);
+    auto parallel = suggester.suggestAll(10, 4);
+    assert(serial.size() == graph.nodeIdLimit() && serial == parallel && "Test 4.1 failed: Thread count changed results");
+    for (const auto& user : users) {
+        FriendGraph::NodeId u = user->getGraphId();
+        assert(parallel[u] == suggester.suggestFor(u, 10) && "Test 4.2 failed: Batch and single-user differ");
+    }
+    std::cout << "Test 4 passed: Batch suggestions" << std::endl;
+}
+
+int main() {
+    try {
+        testSingleUser();
+        testBatch();
+        std::cout << "\nAll FriendSuggester unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
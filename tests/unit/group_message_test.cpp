@@ -0,0 +1,140 @@
+#include "../../include/group_message.h"
+#include "../../include/conversation.h"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+void testGroupMessageBitmaps() {
+    std::cout << "Testing Group Message Bitmaps..." << std::endl;
+
+    // Test 1: Create valid and invalid messages
+    GroupMessage msg(1, "Hello, group!");
+    assert(msg.getSenderId() == 1 && msg.getContent() == "Hello, group!" && "Test 1.1 failed: Field mismatch");
+    assert(msg.recipientCount() == 0 && !msg.isDeliveredTo(0) && "Test 1.2 failed: New message has no recipients");
+    try {
+        GroupMessage invalid(0, "No sender");
+        assert(false && "Test 1.3 failed: Should throw for invalid sender");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "ValidationError" && "Test 1.4 failed: Wrong exception type");
+    }
+    std::cout << "Test 1 passed: Group message creation" << std::endl;
+
+    // Test 2: Delivery covers the recipients bitmap minus the sender, across words
+    std::vector<uint64_t> recipients(3, 0);
+    for (std::size_t slot : {0, 5, 63, 64, 130}) {
+        recipients[slot / 64] |= uint64_t(1) << (slot % 64);
+    }
+    msg.deliver(recipients, 5);
+    assert(msg.recipientCount() == 4 && "Test 2.1 failed: Recipient count mismatch");
+    assert(msg.isDeliveredTo(63) && msg.isDeliveredTo(64) && msg.isDeliveredTo(130) && "Test 2.2 failed: Delivery");
+    assert(!msg.isDeliveredTo(5) && !msg.isDeliveredTo(1) && !msg.isDeliveredTo(500) &&
+           "Test 2.3 failed: Sender and other slots are not recipients");
+
+    // Test 3: Read bits are set once, only for recipients
+    assert(msg.markReadBy(64) && !msg.markReadBy(64) && "Test 3.1 failed: Slot should be marked once");
+    assert(!msg.markReadBy(5) && !msg.markReadBy(500) && "Test 3.2 failed: Non-recipients cannot read");
+    assert(msg.isReadBy(64) && !msg.isReadBy(63) && msg.readCount() == 1 && !msg.isReadByAll() &&
+           "Test 3.3 failed: Read state mismatch");
+    msg.markReadBy(0);
+    msg.markReadBy(63);
+    msg.markReadBy(130);
+    assert(msg.isReadByAll() && "Test 3.4 failed: Every recipient has read");
+    std::cout << "Test 2-3 passed: Delivery and read bitmaps" << std::endl;
+}
+
+void testGroupConversation() {
+    std::cout << "\nTesting Group Conversation Read Tracking..." << std::endl;
+
+    // Test 4: One stored copy reaches every member but the sender
+    Conversation<GroupMessage> conv({1, 2, 3, 4});
+    std::vector<std::shared_ptr<GroupMessage>> sent;
+    for (int i = 0; i < 6; ++i) {
+        sent.push_back(std::make_shared<GroupMessage>(1 + i % 2, "Message " + std::to_string(i),
+                                                      DateTime(1, 1, 2024, 10, i)));
+        conv.addMessage(sent.back());
+    }
+    assert(conv.getMessages().size() == 6 && "Test 4.1 failed: Message count mismatch");
+    assert(sent[0]->recipientCount() == 3 && "Test 4.2 failed: Delivered to the other members");
+    assert(conv.unreadCount(3) == 6 && conv.unreadCount(1) == 3 && conv.unreadCount(2) == 3 &&
+           "Test 4.3 failed: Own messages are not unread");
+    try {
+        conv.addMessage(std::make_shared<GroupMessage>(9, "Outsider"));
+        assert(false && "Test 4.4 failed: Non-member should not post");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "ValidationError" && "Test 4.5 failed: Wrong exception type");
+    }
+
+    // Test 5: Reads are per member
+    conv.markAsRead(sent[1], 3);
+    conv.markAsRead(sent[1], 3);
+    assert(conv.unreadCount(3) == 5 && conv.unreadCount(4) == 6 && "Test 5.1 failed: Individual read");
+    assert(conv.isReadBy(sent[1], 3) && !conv.isReadBy(sent[1], 4) && "Test 5.2 failed: isReadBy mismatch");
+    conv.markReadUpTo(3, DateTime(1, 1, 2024, 10, 2));
+    assert(conv.unreadCount(3) == 3 && conv.isReadBy(sent[0], 3) && "Test 5.3 failed: Watermark read");
+    assert(conv.getUnreadMessages(3).size() == 3 && conv.getUnreadMessages(3).front() == sent[3] &&
+           "Test 5.4 failed: Unread messages after the watermark");
+    conv.markAsRead(sent[4], 3);
+    conv.markReadUpTo(3, DateTime(1, 1, 2024, 10, 4));
+    assert(conv.unreadCount(3) == 1 && "Test 5.5 failed: Covered individual reads are not counted twice");
+    conv.markAllAsRead(3);
+    assert(conv.unreadCount(3) == 0 && conv.getUnreadMessages(3).empty() && "Test 5.6 failed: Mark all");
+    assert(conv.unreadCount(4) == 6 && "Test 5.7 failed: Other members are unaffected");
+
+    // Test 6: A late message behind the watermark counts as read
+    auto late = std::make_shared<GroupMessage>(2, "Late", DateTime(1, 1, 2024, 9, 0));
+    conv.addMessage(late);
+    assert(conv.unreadCount(3) == 0 && conv.unreadCount(4) == 7 && "Test 6.1 failed: Late message");
+
+    // Messages from another conversation are rejected, even where the slots line up
+    Conversation<GroupMessage> other({1, 2, 3, 4});
+    auto foreign = std::make_shared<GroupMessage>(1, "Elsewhere", DateTime(1, 1, 2024, 11, 0));
+    other.addMessage(foreign);
+    try {
+        conv.markAsRead(foreign, 3);
+        assert(false && "Test 6.2 failed: Foreign message should be rejected");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "ValidationError" && conv.unreadCount(3) == 0 && !foreign->isReadBy(2) &&
+               "Test 6.3 failed: Foreign message should change no counters");
+    }
+    std::cout << "Test 4-6 passed: Per-member read tracking" << std::endl;
+}
+
+void testGroupMembership() {
+    std::cout << "\nTesting Group Membership Changes..." << std::endl;
+
+    // Test 7: New members start at the newest message and keep their slot
+    Conversation<GroupMessage> conv({1, 2});
+    auto before = std::make_shared<GroupMessage>(1, "Before", DateTime(1, 1, 2024, 10, 0));
+    conv.addMessage(before);
+    conv.addParticipant(3);
+    assert(conv.unreadCount(3) == 0 && !before->isDeliveredTo(2) && "Test 7.1 failed: Joiner sees no backlog");
+    auto after = std::make_shared<GroupMessage>(1, "After", DateTime(1, 1, 2024, 11, 0));
+    conv.addMessage(after);
+    assert(after->recipientCount() == 2 && conv.unreadCount(3) == 1 && "Test 7.2 failed: Joiner receives new messages");
+
+    // Test 8: Members who left stop receiving; bulk adds reject outsiders
+    conv.removeParticipant(2);
+    assert(conv.unreadCount(2) == 0 && "Test 8.1 failed: Former member has no unread count");
+    auto rejections = conv.addMessages({std::make_shared<GroupMessage>(3, "Bulk", DateTime(1, 1, 2024, 12, 0)),
+                                        std::make_shared<GroupMessage>(2, "Gone", DateTime(1, 1, 2024, 12, 1)),
+                                        nullptr});
+    assert(rejections.size() == 2 && rejections[0].index == 1 && rejections[1].index == 2 &&
+           "Test 8.2 failed: Rejections mismatch");
+    assert(conv.getMessages().back()->recipientCount() == 1 && conv.unreadCount(1) == 1 &&
+           "Test 8.3 failed: Only current members receive");
+    std::cout << "Test 7-8 passed: Membership changes" << std::endl;
+}
+
+int main() {
+    try {
+        testGroupMessageBitmaps();
+        testGroupConversation();
+        testGroupMembership();
+        std::cout << "\nAll group message tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,92 @@
+#include "../../include/id_generator.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+struct SequentialTag {};
+struct ConcurrentTag {};
+struct ReloadTag {};
+
+void testSequentialIds() {
+    std::cout << "Testing Sequential IDs..." << std::endl;
+
+    // Test 1: IDs start at 1 and increase on one thread
+    int first = IdGenerator<SequentialTag>::next();
+    assert(first == 1 && "Test 1.1 failed: First ID should be 1");
+    int previous = first;
+    for (int i = 0; i < 3 * IdGenerator<SequentialTag>::BLOCK_SIZE; ++i) {
+        int id = IdGenerator<SequentialTag>::next();
+        assert(id == previous + 1 && "Test 1.2 failed: IDs on one thread should be consecutive");
+        previous = id;
+    }
+    std::cout << "Test 1 passed: Sequential IDs" << std::endl;
+
+    // Test 2: Each tag has its own sequence
+    assert(IdGenerator<ReloadTag>::next() == 1 && "Test 2.1 failed: Tags should not share IDs");
+    std::cout << "Test 2 passed: Independent tags" << std::endl;
+}
+
+void testConcurrentIds() {
+    std::cout << "\nTesting Concurrent IDs..." << std::endl;
+
+    // Test 3: IDs are unique across threads
+    const int threadCount = 8;
+    const int perThread = 10000;
+    std::vector<std::vector<int>> ids(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([t, &ids]() {
+            for (int i = 0; i < perThread; ++i) {
+                ids[t].push_back(IdGenerator<ConcurrentTag>::next());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::vector<int> all;
+    for (const auto& list : ids) {
+        assert(std::is_sorted(list.begin(), list.end()) && "Test 3.1 failed: IDs should increase within a thread");
+        all.insert(all.end(), list.begin(), list.end());
+    }
+    std::sort(all.begin(), all.end());
+    assert(std::adjacent_find(all.begin(), all.end()) == all.end() && "Test 3.2 failed: Duplicate ID handed out");
+    assert(all.front() > 0 && "Test 3.3 failed: IDs should be positive");
+    std::cout << "Test 3 passed: Unique IDs across threads" << std::endl;
+}
+
+void testObserve() {
+    std::cout << "\nTesting Reseeding After Reload..." << std::endl;
+
+    // Test 4: observe() moves every thread past the loaded IDs, even a thread
+    // that still holds part of an earlier block
+    int before = IdGenerator<ReloadTag>::next();
+    IdGenerator<ReloadTag>::observe(5000);
+    int after = IdGenerator<ReloadTag>::next();
+    assert(before < 5000 && after > 5000 && "Test 4.1 failed: IDs should skip past observed ID");
+
+    int fromOtherThread = 0;
+    std::thread other([&fromOtherThread]() { fromOtherThread = IdGenerator<ReloadTag>::next(); });
+    other.join();
+    assert(fromOtherThread > 5000 && fromOtherThread != after && "Test 4.2 failed: Other threads should skip too");
+
+    // Test 5: Observing a lower ID does not move the sequence back
+    IdGenerator<ReloadTag>::observe(10);
+    assert(IdGenerator<ReloadTag>::next() > after && "Test 5.1 failed: Sequence should never move back");
+    std::cout << "Test 4-5 passed: Reseeding after reload" << std::endl;
+}
+
+int main() {
+    try {
+        testSequentialIds();
+        testConcurrentIds();
+        testObserve();
+        std::cout << "\nAll IdGenerator unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
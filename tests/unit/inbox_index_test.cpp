@@ -0,0 +1,102 @@
+#include "../../include/inbox_index.h"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+void testOrdering() {
+    std::cout << "Testing Inbox Ordering..." << std::endl;
+
+    // Test 1: Conversations are listed most recently active first
+    InboxIndex index;
+    index.touch(1, 10, DateTime(1, 1, 2024, 9, 0));
+    index.touch(1, 11, DateTime(1, 1, 2024, 11, 0));
+    index.touch(1, 12, DateTime(1, 1, 2024, 10, 0));
+    auto inbox = index.getInbox(1, 10);
+    assert(inbox.size() == 3 && "Test 1.1 failed: Inbox should list every conversation");
+    assert(inbox[0].conversationId == 11 && inbox[1].conversationId == 12 && inbox[2].conversationId == 10 &&
+           "Test 1.2 failed: Inbox should be newest first");
+
+    // Test 2: New activity moves a conversation to the top; older activity does not move it back
+    index.touch(1, 10, DateTime(1, 1, 2024, 12, 0));
+    index.touch(1, 11, DateTime(1, 1, 2024, 8, 0));
+    inbox = index.getInbox(1, 10);
+    assert(inbox[0].conversationId == 10 && inbox[1].conversationId == 11 &&
+           "Test 2.1 failed: Touch should only move a conversation forward");
+    assert(index.conversationCount(1) == 3 && "Test 2.2 failed: Touch should not duplicate entries");
+
+    // Test 3: Conversations without activity are listed last
+    index.add(1, 13);
+    index.add(1, 10);
+    inbox = index.getInbox(1, 10);
+    assert(inbox.size() == 4 && inbox.back().conversationId == 13 &&
+           "Test 3.1 failed: Empty conversation should be last");
+    assert(inbox[0].conversationId == 10 && "Test 3.2 failed: add() should not move a listed conversation");
+    assert(index.getInbox(2, 10).empty() && "Test 3.3 failed: Unknown user should have an empty inbox");
+    std::cout << "Test 1-3 passed: Inbox ordering" << std::endl;
+}
+
+void testPaging() {
+    std::cout << "\nTesting Inbox Paging..." << std::endl;
+
+    // Test 4: Pages follow on from the last row, including rows with equal times
+    InboxIndex index;
+    for (int id = 1; id <= 25; ++id) {
+        index.touch(7, id, DateTime(1, 1, 2024, 10, id % 5));
+    }
+    std::vector<int> seen;
+    auto page = index.getInbox(7, 10);
+    while (!page.empty()) {
+        for (const auto& entry : page) {
+            seen.push_back(entry.conversationId);
+        }
+        page = index.getInboxAfter(7, page.back(), 10);
+    }
+    assert(seen.size() == 25 && "Test 4.1 failed: Paging should visit every conversation once");
+    auto all = index.getInbox(7, 100);
+    for (size_t i = 0; i < all.size(); ++i) {
+        assert(all[i].conversationId == seen[i] && "Test 4.2 failed: Pages should match the full listing");
+        assert((i == 0 || !(all[i - 1].lastActivity < all[i].lastActivity)) && "Test 4.3 failed: Order");
+    }
+    std::cout << "Test 4 passed: Inbox paging" << std::endl;
+}
+
+void testUnread() {
+    std::cout << "\nTesting Unread Counts..." << std::endl;
+
+    // Test 5: Unread counts are kept per conversation and in total
+    InboxIndex index;
+    index.touch(1, 10, DateTime(1, 1, 2024, 9, 0));
+    index.touch(1, 11, DateTime(1, 1, 2024, 10, 0));
+    index.setUnread(1, 10, 3);
+    index.setUnread(1, 11, 2);
+    assert(index.totalUnread(1) == 5 && "Test 5.1 failed: Total unread mismatch");
+    index.setUnread(1, 10, 1);
+    assert(index.totalUnread(1) == 3 && "Test 5.2 failed: Total should follow updates");
+    assert(index.getInbox(1, 1)[0].unread == 2 && "Test 5.3 failed: Entry unread mismatch");
+    index.setUnread(1, 99, 4);
+    index.setUnread(2, 10, 4);
+    assert(index.totalUnread(1) == 3 && index.totalUnread(2) == 0 &&
+           "Test 5.4 failed: Unlisted conversations should be ignored");
+
+    // Test 6: Removing a conversation drops its entry and its unread count
+    index.remove(1, 10);
+    assert(index.totalUnread(1) == 2 && index.conversationCount(1) == 1 &&
+           "Test 6.1 failed: Remove should drop the entry");
+    index.remove(1, 11);
+    assert(index.conversationCount(1) == 0 && index.getInbox(1, 10).empty() &&
+           "Test 6.2 failed: Inbox should be empty");
+    std::cout << "Test 5-6 passed: Unread counts" << std::endl;
+}
+
+int main() {
+    try {
+        testOrdering();
+        testPaging();
+        testUnread();
+        std::cout << "\nAll InboxIndex unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
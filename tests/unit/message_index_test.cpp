@@ -0,0 +1,110 @@
+#include "../../include/message_index.h"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Minimal message: the index only needs getContent()
+struct TextMessage {
+    std::string content;
+    explicit TextMessage(const std::string& text) : content(text) {}
+    const std::string& getContent() const { return content; }
+};
+
+using Index = MessageIndex<TextMessage>;
+
+std::shared_ptr<TextMessage> add(Index& index, int conversationId, const std::string& text) {
+    auto message = std::make_shared<TextMessage>(text);
+    index.add(conversationId, message);
+    return message;
+}
+
+void testTokenize() {
+    std::cout << "Testing Tokenizer..." << std::endl;
+    
+    // Test 1: Case folding and punctuation
+    auto tokens = Index::tokenize("Hello, WORLD! it's 2024...");
+    assert(tokens.size() == 5 && tokens[0] == "hello" && tokens[1] == "world" && tokens[2] == "it" &&
+           tokens[3] == "s" && tokens[4] == "2024" && "Test 1.1 failed: Token mismatch");
+    assert(Index::tokenize("  ,;  ").empty() && "Test 1.2 failed: Punctuation only should give no tokens");
+    assert(Index::tokenize("caf\xC3\xA9 ok")[0] == "caf\xC3\xA9" && "Test 1.3 failed: UTF-8 should stay inside tokens");
+    std::cout << "Test 1 passed: Tokenizer" << std::endl;
+}
+
+void testTermSearch() {
+    std::cout << "\nTesting Term Search..." << std::endl;
+    
+    Index index;
+    auto lunch = add(index, 1, "Lunch tomorrow at noon?");
+    auto noon = add(index, 1, "Noon works, see you at lunch");
+    auto other = add(index, 2, "Lunch was great today");
+    add(index, 2, "Unrelated message");
+    
+    // Test 2: Single and multi-term queries
+    auto results = index.search("LUNCH");
+    assert(results.size() == 3 && results[0] == lunch && results[1] == noon && results[2] == other &&
+           "Test 2.1 failed: Term results should be in index order");
+    results = index.search("lunch noon");
+    assert(results.size() == 2 && results[0] == lunch && results[1] == noon && "Test 2.2 failed: All terms must match");
+    assert(index.search("dinner").empty() && "Test 2.3 failed: Unknown term should match nothing");
+    assert(index.search("lunch dinner").empty() && "Test 2.4 failed: Missing term should match nothing");
+    assert(index.search("").empty() && "Test 2.5 failed: Empty query should match nothing");
+    std::cout << "Test 2 passed: Term queries" << std::endl;
+    
+    // Test 3: Scoped to a set of conversations
+    results = index.search("lunch", {2});
+    assert(results.size() == 1 && results[0] == other && "Test 3.1 failed: Scope should filter conversations");
+    assert(index.search("lunch", {3}).empty() && "Test 3.2 failed: Unknown conversation should match nothing");
+    assert(index.search("lunch", {2, 1}).size() == 3 && "Test 3.3 failed: Multiple conversations");
+    std::cout << "Test 3 passed: Scoped queries" << std::endl;
+}
+
+void testPhraseSearch() {
+    std::cout << "\nTesting Phrase Search..." << std::endl;
+    
+    Index index;
+    auto exact = add(index, 1, "See you at the movies tonight");
+    auto reordered = add(index, 1, "The movies? See you there at eight");
+    auto repeated = add(index, 2, "the the movies the end");
+    
+    // Test 4: Words must be consecutive and in order
+    auto results = index.searchPhrase("at the movies");
+    assert(results.size() == 1 && results[0] == exact && "Test 4.1 failed: Phrase should match exact sequence");
+    results = index.searchPhrase("the movies");
+    assert(results.size() == 3 && "Test 4.2 failed: Phrase should match every occurrence");
+    assert(index.searchPhrase("movies the", {1}).empty() && "Test 4.3 failed: Phrase order matters");
+    results = index.searchPhrase("movies the", {2});
+    assert(results.size() == 1 && results[0] == repeated && "Test 4.4 failed: Repeated terms in phrase");
+    results = index.search("movies see");
+    assert(results.size() == 2 && results[1] == reordered && "Test 4.5 failed: Term query ignores order");
+    std::cout << "Test 4 passed: Phrase queries" << std::endl;
+}
+
+void testCompression() {
+    std::cout << "\nTesting Postings Compression..." << std::endl;
+    
+    // Test 5: Postings cost a few bytes per occurrence and survive large gaps
+    Index index;
+    for (int i = 0; i < 10000; ++i) {
+        add(index, 1, i % 1000 == 0 ? "rare common" : "common");
+    }
+    assert(index.size() == 10000 && "Test 5.1 failed: Document count");
+    assert(index.postingsSize() < 10000 * 4 && "Test 5.2 failed: Postings should be compact");
+    assert(index.search("rare").size() == 10 && "Test 5.3 failed: Sparse postings");
+    assert(index.searchPhrase("rare common").size() == 10 && "Test 5.4 failed: Phrase across large gaps");
+    std::cout << "Test 5 passed: Postings compression" << std::endl;
+}
+
+int main() {
+    try {
+        testTokenize();
+        testTermSearch();
+        testPhraseSearch();
+        testCompression();
+        std::cout << "\nAll MessageIndex unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,101 @@
+#include "../../include/message_segment.h"
+#include "../../include/message.h"
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+void testRoundTrip() {
+    std::cout << "Testing Segment Round Trip..." << std::endl;
+    
+    // Test 1: Every field survives writing and mapping
+    std::vector<std::shared_ptr<Message>> messages;
+    for (int i = 0; i < 100; ++i) {
+        auto message = std::make_shared<Message>(1 + i % 2, 2 - i % 2, "Message " + std::to_string(i),
+                                                 DateTime(1, 2, 2024, 10, i / 60, i % 60, i));
+        message->setSequence(i + 1);
+        if (i % 3 == 0) message->markAsRead();
+        messages.push_back(message);
+    }
+    messages.push_back(std::make_shared<Message>(1, 2, std::string("binary\0\n\r\xff", 10), DateTime(1, 2, 2024, 11, 0, 0)));
+    
+    std::string path = "data/segments/segment_test.seg";
+    {
+        auto segment = MessageSegment::write(path, messages);
+        assert(std::filesystem::exists(path) && "Test 1.1 failed: Segment file should exist");
+        assert(segment->size() == 101 && !segment->isMapped() && "Test 1.2 failed: Segment should map lazily");
+        assert(segment->getOldest() == messages.front()->getTimestamp() &&
+               segment->getNewest() == messages.back()->getTimestamp() && "Test 1.3 failed: Time bounds");
+        for (size_t i = 0; i < messages.size(); ++i) {
+            StoredMessage stored = segment->at(i);
+            assert(stored.senderId == messages[i]->getSenderId() && stored.receiverId == messages[i]->getReceiverId() &&
+                   "Test 1.4 failed: Participants mismatch");
+            assert(stored.timestamp == messages[i]->getTimestamp() && stored.timestamp.getMicrosecond() == messages[i]->getTimestamp().getMicrosecond() &&
+                   "Test 1.5 failed: Timestamp mismatch");
+            assert(stored.sequence == messages[i]->getSequence() && stored.read == messages[i]->isRead() &&
+                   "Test 1.6 failed: Sequence or read flag mismatch");
+            assert(stored.content == messages[i]->getContent() && "Test 1.7 failed: Content mismatch");
+        }
+        assert(segment->isMapped() && "Test 1.8 failed: Segment should be mapped after a read");
+        segment->unmap();
+        assert(!segment->isMapped() && segment->at(5).content == "Message 5" && "Test 1.9 failed: Remap after unmap");
+    }
+    assert(!std::filesystem::exists(path) && "Test 1.10 failed: Segment should delete its file");
+    std::cout << "Test 1 passed: Segment round trip" << std::endl;
+}
+
+void testCorruption() {
+    std::cout << "\nTesting Segment Validation..." << std::endl;
+    
+    // Test 2: Empty segments and damaged files are rejected
+    try {
+        MessageSegment::write("data/segments/empty.seg", std::vector<std::shared_ptr<Message>>());
+        assert(false && "Test 2.1 failed: Empty segment should be rejected");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "ValidationError" && "Test 2.2 failed: Wrong exception type");
+    }
+    
+    std::string path = "data/segments/corrupt_test.seg";
+    auto segment = MessageSegment::write(path, std::vector<std::shared_ptr<Message>>{std::make_shared<Message>(1, 2, "Hello")});
+    FileManager::getInstance().writeBinaryFile(path, "XXXX garbage");
+    try {
+        segment->at(0);
+        assert(false && "Test 2.3 failed: Corrupt segment should be rejected");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "FileError" && "Test 2.4 failed: Wrong exception type");
+    }
+    
+    // A directory that cannot be created is a FileError too
+    try {
+        MessageSegment::write("/dev/null/segments/blocked.seg",
+                              std::vector<std::shared_ptr<Message>>{std::make_shared<Message>(1, 2, "Hello")});
+        assert(false && "Test 2.5 failed: Unwritable directory should be rejected");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "FileError" && "Test 2.6 failed: Wrong exception type");
+    }
+    
+    // Existing files are never truncated: another process may have them mapped
+    try {
+        MessageSegment::write(path, std::vector<std::shared_ptr<Message>>{std::make_shared<Message>(1, 2, "Again")});
+        assert(false && "Test 2.7 failed: Existing segment file should not be overwritten");
+    } catch (const FacebookException& e) {
+        assert(e.getType() == "FileError" && FileManager::getInstance().readBinaryFile(path) == "XXXX garbage" &&
+               "Test 2.8 failed: Existing file should be left alone");
+    }
+    assert(MessageSegment::processTag().size() == 16 && MessageSegment::processTag() == MessageSegment::processTag() &&
+           "Test 2.9 failed: Process tag should be fixed for the process");
+    std::cout << "Test 2 passed: Segment validation" << std::endl;
+}
+
+int main() {
+    try {
+        testRoundTrip();
+        testCorruption();
+        std::cout << "\nAll MessageSegment unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
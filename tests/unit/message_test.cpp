@@ -46,12 +46,21 @@ void testMessageTimestamp() {
     
     // Test 3: Message timestamps
     Message msg1(1, 2, "First message");
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
     Message msg2(2, 1, "Second message");
     
     assert(msg1 < msg2 && "Test 3.1 failed: First message should have earlier timestamp");
     assert(msg2 > msg1 && "Test 3.2 failed: Second message should have later timestamp");
     assert(!(msg1 == msg2) && "Test 3.3 failed: Messages should not be equal");
+    
+    // Same text at the same instant: the conversation sequence tells them apart
+    DateTime instant(15, 3, 2024, 10, 0, 0);
+    Message first(1, 2, "Same", instant), second(1, 2, "Same", instant);
+    first.setSequence(1);
+    second.setSequence(2);
+    assert(first < second && !(first == second) && "Test 3.4 failed: Equality should agree with ordering");
+    second.setSequence(1);
+    assert(first == second && !(first < second) && !(second < first) && "Test 3.5 failed: Equal messages");
     std::cout << "Test 3 passed: Message timestamps" << std::endl;
 }
 
@@ -79,7 +88,7 @@ void testMessageInConversation() {
     auto unreadBefore = conv.getUnreadMessages(2);
     assert(unreadBefore.size() == 1 && "Test 5.1 failed: Initial unread count wrong");
     
-    msg1->markAsRead();
+    conv.markAsRead(msg1);
     auto unreadAfter = conv.getUnreadMessages(2);
     assert(unreadAfter.empty() && "Test 5.2 failed: Unread count after marking as read");
     std::cout << "Test 5 passed: Message read status in conversation" << std::endl;
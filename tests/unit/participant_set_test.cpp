@@ -0,0 +1,49 @@
+#include "../../include/participant_set.h"
+#include <cassert>
+#include <iostream>
+
+void testSmallGroups() {
+    std::cout << "Testing Small Participant Sets..." << std::endl;
+    
+    // Test 1: Inline membership
+    ParticipantSet set;
+    assert(set.insert(5) && set.insert(2) && set.insert(9) && "Test 1.1 failed: Insert should succeed");
+    assert(!set.insert(2) && "Test 1.2 failed: Duplicate insert should fail");
+    assert(set.contains(2) && set.contains(5) && set.contains(9) && "Test 1.3 failed: Member not found");
+    assert(!set.contains(1) && !set.contains(7) && !set.contains(10) && "Test 1.4 failed: Non-member found");
+    assert(set.size() == 3 && set.isInline() && "Test 1.5 failed: Small set should stay inline");
+    std::cout << "Test 1 passed: Inline membership" << std::endl;
+    
+    // Test 2: Removal
+    assert(set.erase(5) && !set.erase(5) && "Test 2.1 failed: Erase result mismatch");
+    assert(!set.contains(5) && set.contains(9) && set.size() == 2 && "Test 2.2 failed: Erase left set inconsistent");
+    std::cout << "Test 2 passed: Inline removal" << std::endl;
+}
+
+void testLargeGroups() {
+    std::cout << "\nTesting Large Participant Sets..." << std::endl;
+    
+    // Test 3: Switch to hashed storage past the inline capacity
+    ParticipantSet set;
+    for (int id = 1; id <= 500; ++id) {
+        assert(set.insert(id * 3) && "Test 3.1 failed: Insert should succeed");
+    }
+    assert(!set.isInline() && set.size() == 500 && "Test 3.2 failed: Large set should be hashed");
+    for (int id = 1; id <= 500; ++id) {
+        assert(set.contains(id * 3) && !set.contains(id * 3 + 1) && "Test 3.3 failed: Membership mismatch");
+    }
+    assert(!set.insert(3) && set.erase(3) && !set.contains(3) && "Test 3.4 failed: Large set update mismatch");
+    std::cout << "Test 3 passed: Large group membership" << std::endl;
+}
+
+int main() {
+    try {
+        testSmallGroups();
+        testLargeGroups();
+        std::cout << "\nAll ParticipantSet unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
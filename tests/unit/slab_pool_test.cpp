@@ -0,0 +1,74 @@
+#include "../../include/slab_pool.h"
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Counts live instances so tests can check construction and destruction
+struct Tracked {
+    static int live;
+    std::string name;
+
+    explicit Tracked(const std::string& name) : name(name) {
+        if (name.empty()) {
+            throw std::invalid_argument("empty name");
+        }
+        ++live;
+    }
+    ~Tracked() { --live; }
+};
+int Tracked::live = 0;
+
+void testSlabPoolStorage() {
+    std::cout << "Testing SlabPool Storage..." << std::endl;
+    
+    // Test 1: Objects keep their address as the pool grows
+    {
+        SlabPool<Tracked, 16> pool;
+        std::vector<Tracked*> addresses;
+        for (int i = 0; i < 100; ++i) {
+            addresses.push_back(pool.emplace("item" + std::to_string(i)));
+        }
+        assert(pool.size() == 100 && pool.slabCount() == 7 && "Test 1.1 failed: Slab count mismatch");
+        for (int i = 0; i < 100; ++i) {
+            assert(&pool[i] == addresses[i] && "Test 1.2 failed: Object moved");
+            assert(pool[i].name == "item" + std::to_string(i) && "Test 1.3 failed: Object content mismatch");
+        }
+        assert(Tracked::live == 100 && "Test 1.4 failed: Live count mismatch");
+    }
+    assert(Tracked::live == 0 && "Test 1.5 failed: Pool should destroy every object");
+    std::cout << "Test 1 passed: Stable storage and bulk release" << std::endl;
+}
+
+void testSlabPoolFailures() {
+    std::cout << "\nTesting SlabPool Failures..." << std::endl;
+    
+    // Test 2: A throwing constructor leaves the pool unchanged
+    SlabPool<Tracked, 4> pool;
+    pool.emplace("first");
+    try {
+        pool.emplace("");
+        assert(false && "Test 2.1 failed: Constructor should throw");
+    } catch (const std::invalid_argument&) {
+    }
+    assert(pool.size() == 1 && Tracked::live == 1 && "Test 2.2 failed: Failed emplace changed the pool");
+    
+    // Test 3: popBack destroys the newest object
+    pool.emplace("second");
+    pool.popBack();
+    assert(pool.size() == 1 && Tracked::live == 1 && pool[0].name == "first" && "Test 3.1 failed: popBack mismatch");
+    std::cout << "Test 2-3 passed: Failure handling" << std::endl;
+}
+
+int main() {
+    try {
+        testSlabPoolStorage();
+        testSlabPoolFailures();
+        std::cout << "\nAll SlabPool unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
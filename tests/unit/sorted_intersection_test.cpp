@@ -0,0 +1,77 @@
+#include "../../include/sorted_intersection.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+std::vector<uint32_t> randomSet(std::mt19937& rng, size_t size, uint32_t range) {
+    std::vector<uint32_t> values;
+    for (size_t i = 0; i < size; ++i) {
+        values.push_back(rng() % range);
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+std::vector<uint32_t> intersect(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    std::vector<uint32_t> result;
+    SortedIntersection::forEach(a.data(), a.size(), b.data(), b.size(),
+                                [&result](uint32_t value) { result.push_back(value); });
+    return result;
+}
+
+void testAgainstReference(std::mt19937& rng, size_t aSize, size_t bSize, uint32_t range, const char* failure) {
+    for (int round = 0; round < 50; ++round) {
+        auto a = randomSet(rng, aSize, range);
+        auto b = randomSet(rng, bSize, range);
+        std::vector<uint32_t> expected;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        assert(intersect(a, b) == expected && failure);
+        assert(intersect(b, a) == expected && failure);
+        assert(SortedIntersection::count(a.data(), a.size(), b.data(), b.size()) == expected.size() && failure);
+    }
+}
+
+void testIntersection() {
+    std::cout << "Testing Sorted Intersection..." << std::endl;
+    std::mt19937 rng(11);
+
+    // Test 1: Edge cases
+    std::vector<uint32_t> empty;
+    std::vector<uint32_t> some = {1, 5, 9};
+    assert(intersect(empty, some).empty() && intersect(some, empty).empty() && "Test 1.1 failed: Empty input");
+    assert(intersect(some, some) == some && "Test 1.2 failed: Identical input");
+    std::vector<uint32_t> extremes = {0, 7, 0xFFFFFFFE, 0xFFFFFFFF};
+    std::vector<uint32_t> high = {0, 3, 0x80000000, 0xFFFFFFFF};
+    assert(intersect(extremes, high) == (std::vector<uint32_t>{0, 0xFFFFFFFF}) &&
+           "Test 1.3 failed: Values above INT_MAX");
+    std::cout << "Test 1 passed: Edge cases" << std::endl;
+
+    // Test 2: Similar sizes (vectorized merge), including ragged tails
+    for (size_t size : {3, 4, 5, 17, 64, 1000}) {
+        testAgainstReference(rng, size, size + size % 3, static_cast<uint32_t>(size * 3),
+                             "Test 2.1 failed: Merge mismatch");
+    }
+    testAgainstReference(rng, 500, 500, 100000, "Test 2.2 failed: Sparse overlap");
+    std::cout << "Test 2 passed: Merge intersection" << std::endl;
+
+    // Test 3: Skewed sizes (galloping)
+    testAgainstReference(rng, 10, 5000, 20000, "Test 3.1 failed: Galloping mismatch");
+    testAgainstReference(rng, 1, 1000, 2000, "Test 3.2 failed: Single element");
+    testAgainstReference(rng, 40, 40 * SortedIntersection::GALLOP_RATIO, 4000, "Test 3.3 failed: Threshold");
+    std::cout << "Test 3 passed: Galloping intersection" << std::endl;
+}
+
+int main() {
+    try {
+        testIntersection();
+        std::cout << "\nAll SortedIntersection unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,40 @@
+#include "../../include/span.h"
+#include <cassert>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+// Views over temporaries would dangle, and a vector only becomes a span on request
+static_assert(!std::is_constructible<Span<int>, std::vector<int>&&>::value,
+              "Span should not bind to a temporary vector");
+static_assert(!std::is_convertible<const std::vector<int>&, Span<int>>::value,
+              "Span should not be built from a vector implicitly");
+
+void testSpan() {
+    std::cout << "Testing Span..." << std::endl;
+
+    // Test 1: A span sees the vector's elements in place
+    std::vector<int> items = {1, 2, 3, 4, 5};
+    Span<int> all(items);
+    assert(all.size() == 5 && all.begin() == items.data() && "Test 1.1 failed: Span should view the vector");
+    assert(all.front() == 1 && all.back() == 5 && all[2] == 3 && "Test 1.2 failed: Element access");
+    assert(Span<int>().empty() && "Test 1.3 failed: Default span should be empty");
+    std::cout << "Test 1 passed: Span over a vector" << std::endl;
+
+    // Test 2: Subspans are clamped to the span
+    assert(all.subspan(1, 2).size() == 2 && all.subspan(1, 2)[0] == 2 && "Test 2.1 failed: Subspan mismatch");
+    assert(all.subspan(3, static_cast<std::size_t>(-1)).size() == 2 && "Test 2.2 failed: Length should be clamped");
+    assert(all.subspan(9, 1).empty() && "Test 2.3 failed: Offset should be clamped");
+    std::cout << "Test 2 passed: Subspans" << std::endl;
+}
+
+int main() {
+    try {
+        testSpan();
+        std::cout << "\nAll Span unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,84 @@
+#include "../../include/timeline.h"
+#include <cassert>
+#include <iostream>
+#include <utility>
+
+// Orders pairs by key only, so the second member records arrival order
+struct KeyLess {
+    bool operator()(const std::pair<int, int>& a, const std::pair<int, int>& b) const {
+        return a.first < b.first;
+    }
+};
+
+void testTimelineAppend() {
+    std::cout << "Testing Timeline Append..." << std::endl;
+    
+    // Test 1: In-order elements are appended
+    Timeline<std::pair<int, int>, KeyLess> timeline;
+    for (int i = 0; i < 100; ++i) {
+        assert(timeline.insert({i, i}) == static_cast<size_t>(i) && "Test 1.1 failed: In-order element not appended");
+    }
+    assert(timeline.size() == 100 && "Test 1.2 failed: Size mismatch");
+    std::cout << "Test 1 passed: In-order append" << std::endl;
+    
+    // Test 2: Equal keys keep arrival order
+    timeline.insert({99, 1000});
+    assert(timeline.back().second == 1000 && "Test 2.1 failed: Equal key should go after existing ones");
+    std::cout << "Test 2 passed: Stable append" << std::endl;
+}
+
+void testTimelineLateArrivals() {
+    std::cout << "\nTesting Timeline Late Arrivals..." << std::endl;
+    
+    // Test 3: Late elements land at their sorted position at any depth
+    Timeline<std::pair<int, int>, KeyLess> timeline;
+    for (int i = 0; i < 1000; i += 2) {
+        timeline.insert({i, 0});
+    }
+    assert(timeline.insert({997, 1}) == 499 && "Test 3.1 failed: Slightly late element misplaced");
+    assert(timeline.insert({501, 1}) == 251 && "Test 3.2 failed: Very late element misplaced");
+    assert(timeline.insert({-5, 1}) == 0 && "Test 3.3 failed: Oldest element misplaced");
+    assert(timeline.insert({500, 1}) == 252 && "Test 3.4 failed: Equal key should follow existing one");
+    for (size_t i = 1; i < timeline.size(); ++i) {
+        assert(!KeyLess()(timeline[i], timeline[i - 1]) && "Test 3.5 failed: Timeline out of order");
+    }
+    std::cout << "Test 3 passed: Late arrivals" << std::endl;
+}
+
+void testTimelineMerge() {
+    std::cout << "\nTesting Timeline Merge..." << std::endl;
+    
+    // Test 4: A sorted batch interleaves with existing elements
+    Timeline<std::pair<int, int>, KeyLess> timeline;
+    for (int i = 0; i < 10; i += 2) {
+        timeline.insert({i, 0});
+    }
+    timeline.merge({{-1, 1}, {3, 1}, {4, 1}, {20, 1}});
+    assert(timeline.size() == 9 && "Test 4.1 failed: Size after merge");
+    for (size_t i = 1; i < timeline.size(); ++i) {
+        assert(!KeyLess()(timeline[i], timeline[i - 1]) && "Test 4.2 failed: Timeline out of order after merge");
+    }
+    assert(timeline.front().first == -1 && timeline.back().first == 20 && "Test 4.3 failed: Merge bounds");
+    assert(timeline[4].first == 4 && timeline[4].second == 0 && timeline[5].second == 1 &&
+           "Test 4.4 failed: Equal key from batch should follow existing one");
+    
+    // Test 5: A batch entirely after the tail is appended
+    timeline.merge({{30, 2}, {31, 2}});
+    assert(timeline.size() == 11 && timeline.back().first == 31 && "Test 5.1 failed: Append merge");
+    timeline.merge({});
+    assert(timeline.size() == 11 && "Test 5.2 failed: Empty merge should not change timeline");
+    std::cout << "Test 4-5 passed: Merge" << std::endl;
+}
+
+int main() {
+    try {
+        testTimelineAppend();
+        testTimelineLateArrivals();
+        testTimelineMerge();
+        std::cout << "\nAll Timeline unit tests passed successfully!" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}